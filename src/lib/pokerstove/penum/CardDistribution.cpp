@@ -177,6 +177,18 @@ std::string CardDistribution::display() const
     return str();
 }
 
+void CardDistribution::insert(const CardSet& hand, double weight)
+{
+    map<CardSet, double>::iterator it = _weights.find(hand);
+    if (it != _weights.end())
+    {
+        it->second = weight;
+        return;
+    }
+    _weights[hand] = weight;
+    _handList.push_back(hand);
+}
+
 void CardDistribution::removeCards(const CardSet& dead)
 {
     for (size_t i = 0; i < _handList.size(); i++)
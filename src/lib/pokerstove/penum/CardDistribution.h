@@ -37,6 +37,12 @@ public:
 
     void removeCards(const CardSet& dead);
 
+    /**
+     * add a hand to the distribution, if the hand is already present only
+     * the weight is updated
+     */
+    void insert(const CardSet& hand, double weight = 1.0);
+
     /**
      * return the total weight in the distribution
      */
@@ -0,0 +1,119 @@
+/**
+ * Copyright (c) 2012 Andrew Prock. All rights reserved.
+ */
+#include "DisjointOdometer.h"
+
+#include <pokerstove/peval/Card.h>
+#include <pokerstove/util/lastbit.h>
+
+using namespace std;
+
+namespace pokerstove
+{
+
+DisjointOdometer::DisjointOdometer(const vector<CardDistribution>& dists,
+                                   const CardSet& dead)
+    : _masks(dists.size())
+    , _buckets(dists.size(), vector<vector<uint32_t>>(STANDARD_DECK_SIZE))
+    , _stamps(dists.size())
+    , _pos(dists.size(), 0)
+    , _dead(dists.size(), 0)
+    , _stamp(dists.size(), 0)
+    , _nextStamp(0)
+    , _filtered(0)
+    , _valid(false)
+{
+    for (size_t d = 0; d < dists.size(); d++)
+    {
+        const CardDistribution& dist = dists[d];
+        _masks[d].resize(dist.size());
+        _stamps[d].assign(dist.size(), 0);
+        for (size_t i = 0; i < dist.size(); i++)
+        {
+            uint64_t mask = dist[i].mask();
+            _masks[d][i] = mask;
+            while (mask)
+            {
+                _buckets[d][lastbit(mask)].push_back(static_cast<uint32_t>(i));
+                mask &= mask - 1;
+            }
+        }
+    }
+
+    if (dists.empty())
+        return;
+    _dead[0] = dead.mask();
+    enter(0);
+    _valid = seek(0);
+}
+
+bool DisjointOdometer::next()
+{
+    if (!_valid)
+        return false;
+    size_t last = _pos.size() - 1;
+    _pos[last]++;
+    _valid = seek(last);
+    return _valid;
+}
+
+double DisjointOdometer::fraction() const
+{
+    double fraction = 0.0;
+    double scale = 1.0;
+    for (size_t d = 0; d < _pos.size(); d++)
+    {
+        scale /= _masks[d].size();
+        fraction += _pos[d] * scale;
+    }
+    return fraction;
+}
+
+void DisjointOdometer::enter(size_t depth)
+{
+    // stamp out every hand which uses a card already in play
+    uint64_t stamp = ++_nextStamp;
+    _stamp[depth] = stamp;
+    _pos[depth] = 0;
+    vector<uint64_t>& stamps = _stamps[depth];
+    uint64_t dead = _dead[depth];
+    while (dead)
+    {
+        for (uint32_t i : _buckets[depth][lastbit(dead)])
+            stamps[i] = stamp;
+        dead &= dead - 1;
+    }
+}
+
+bool DisjointOdometer::seek(size_t depth)
+{
+    while (true)
+    {
+        const vector<uint64_t>& stamps = _stamps[depth];
+        size_t n = stamps.size();
+        size_t& pos = _pos[depth];
+        while (pos < n && stamps[pos] == _stamp[depth])
+        {
+            pos++;
+            _filtered++;
+        }
+
+        // this depth is exhausted, back up to the previous one
+        if (pos == n)
+        {
+            if (depth == 0)
+                return false;
+            depth--;
+            _pos[depth]++;
+            continue;
+        }
+
+        if (depth + 1 == _pos.size())
+            return true;
+        _dead[depth + 1] = _dead[depth] | _masks[depth][pos];
+        depth++;
+        enter(depth);
+    }
+}
+
+}  // namespace pokerstove
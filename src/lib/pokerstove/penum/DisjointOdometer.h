@@ -0,0 +1,91 @@
+/**
+ * Copyright (c) 2012 Andrew Prock. All rights reserved.
+ */
+#ifndef PENUM_DISJOINTODOMETER_H_
+#define PENUM_DISJOINTODOMETER_H_
+
+#include <cstdint>
+#include <vector>
+#include <pokerstove/peval/CardSet.h>
+#include "CardDistribution.h"
+
+namespace pokerstove
+{
+/**
+ * An odometer over one hand from each distribution which only stops on
+ * tuples of hands that share no cards with each other or with the dead
+ * cards.  The tuples are visited in the same order as the plain Odometer
+ * would visit them, the colliding ones are just never reached.
+ *
+ * The hands of each distribution are bucketed by card.  When a hand is
+ * picked for a player, the hands of the next player which contain any
+ * card already in use are stamped out through the buckets, and only the
+ * unstamped hands are iterated.  This prunes whole subtrees of the
+ * index space, which matters for three and four way range calculations
+ * where most index combinations collide.
+ *
+ * usage:
+ *
+ *   DisjointOdometer o(dists, board);
+ *   if (o.valid())
+ *       do
+ *       {
+ *           use(dists[0][o[0]], dists[1][o[1]], ...);
+ *       } while (o.next());
+ */
+class DisjointOdometer
+{
+public:
+    DisjointOdometer(const std::vector<CardDistribution>& dists,
+                     const CardSet& dead = CardSet());
+
+    size_t size() const { return _pos.size(); }
+
+    /**
+     * false if there is no disjoint tuple at all
+     */
+    bool valid() const { return _valid; }
+
+    /**
+     * advance to the next disjoint tuple, false when done
+     */
+    bool next();
+
+    /**
+     * index of the current hand of the ith distribution
+     */
+    size_t operator[](size_t i) const { return _pos[i]; }
+
+    /**
+     * the linear position of the current tuple in the full index space,
+     * as a fraction in [0,1), the same value the plain Odometer would be
+     * at
+     */
+    double fraction() const;
+
+    /**
+     * number of hands skipped so far because they collided with earlier
+     * picks
+     */
+    uint64_t filtered() const { return _filtered; }
+
+private:
+    void enter(size_t depth);
+    bool seek(size_t depth);
+
+    // per distribution: card masks, hand indices by card, and stamps
+    std::vector<std::vector<uint64_t>> _masks;
+    std::vector<std::vector<std::vector<uint32_t>>> _buckets;
+    std::vector<std::vector<uint64_t>> _stamps;
+
+    std::vector<size_t> _pos;
+    std::vector<uint64_t> _dead;    // cards in use before each depth
+    std::vector<uint64_t> _stamp;   // current stamp of each depth
+    uint64_t _nextStamp;
+    uint64_t _filtered;
+    bool _valid;
+};
+
+}  // namespace pokerstove
+
+#endif  // PENUM_DISJOINTODOMETER_H_
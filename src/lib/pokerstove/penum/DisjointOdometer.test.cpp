@@ -0,0 +1,93 @@
+#include "DisjointOdometer.h"
+#include "Odometer.h"
+#include "RangeDistribution.h"
+#include <gtest/gtest.h>
+
+using namespace pokerstove;
+using namespace std;
+
+namespace
+{
+// the disjoint tuples, in order, found the slow way
+vector<vector<size_t>> slowTuples(const vector<CardDistribution>& dists,
+                                  const CardSet& dead,
+                                  vector<double>& fractions)
+{
+    vector<size_t> sizes;
+    double total = 1.0;
+    for (const CardDistribution& d : dists)
+    {
+        sizes.push_back(d.size());
+        total *= d.size();
+    }
+
+    vector<vector<size_t>> tuples;
+    Odometer o(sizes);
+    double step = 0.0;
+    do
+    {
+        CardSet used = dead;
+        bool disjoint = true;
+        for (size_t i = 0; i < dists.size(); i++)
+        {
+            disjoint = disjoint && used.disjoint(dists[i][o[i]]);
+            used |= dists[i][o[i]];
+        }
+        if (disjoint)
+        {
+            vector<size_t> tuple;
+            for (size_t i = 0; i < o.size(); i++)
+                tuple.push_back(o[i]);
+            tuples.push_back(tuple);
+            fractions.push_back(step / total);
+        }
+        step += 1.0;
+    } while (o.next());
+    return tuples;
+}
+}  // namespace
+
+TEST(DisjointOdometer, MatchesOdometer)
+{
+    const char* ranges[] = {"AA,KK,AKs", "AK,KQs,AQ", "A2s+,KK", "QQ+"};
+    vector<CardDistribution> dists;
+    for (const char* r : ranges)
+    {
+        RangeDistribution dist;
+        ASSERT_TRUE(dist.parse(r));
+        dists.push_back(dist.data());
+    }
+    CardSet board("As7d2c");
+
+    vector<double> fractions;
+    vector<vector<size_t>> expected = slowTuples(dists, board, fractions);
+    ASSERT_FALSE(expected.empty());
+
+    DisjointOdometer o(dists, board);
+    ASSERT_TRUE(o.valid());
+    size_t n = 0;
+    do
+    {
+        ASSERT_LT(n, expected.size());
+        for (size_t i = 0; i < o.size(); i++)
+            EXPECT_EQ(expected[n][i], o[i]);
+        EXPECT_NEAR(fractions[n], o.fraction(), 1e-12);
+        n++;
+    } while (o.next());
+    EXPECT_EQ(expected.size(), n);
+    EXPECT_GT(o.filtered(), 0);
+}
+
+TEST(DisjointOdometer, NoTuples)
+{
+    vector<CardDistribution> dists;
+    dists.push_back(CardDistribution(CardSet("AcAd")));
+    dists.push_back(CardDistribution(CardSet("AcKd")));
+    DisjointOdometer o(dists);
+    EXPECT_FALSE(o.valid());
+    EXPECT_FALSE(o.next());
+
+    DisjointOdometer dead(vector<CardDistribution>(1, CardDistribution(CardSet("AcAd"))),
+                          CardSet("Ad"));
+    EXPECT_FALSE(dead.valid());
+}
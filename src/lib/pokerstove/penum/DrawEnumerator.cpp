@@ -0,0 +1,571 @@
+/**
+ * Copyright (c) 2012 Andrew Prock. All rights reserved.
+ */
+#include "DrawEnumerator.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <thread>
+
+#include "EnumerationMonitor.h"
+#include <pokerstove/peval/Card.h>
+#include <pokerstove/peval/PokerHandEvaluation.h>
+#include <pokerstove/peval/ShowdownTally.h>
+#include <pokerstove/util/combinations.h>
+
+using std::runtime_error;
+using std::vector;
+
+namespace pokerstove
+{
+
+namespace
+{
+// how many leaves are dealt between checks for cancellation, and how
+// many random deals make up one unit of sampling work
+const uint64_t kCheckInterval = 1 << 12;
+const uint64_t kChunkTrials = 1 << 12;
+
+size_t countRounds(const vector<DrawHand>& hands)
+{
+    size_t rounds = 1;
+    for (const DrawHand& h : hands)
+        rounds = std::max(rounds, h.draws.size());
+    return rounds;
+}
+
+size_t drawsFor(const DrawHand& hand, size_t round)
+{
+    return round < hand.draws.size() ? hand.draws[round] : 0;
+}
+
+CardSet fullDeck()
+{
+    CardSet deck;
+    deck.fill();
+    return deck;
+}
+
+// the best keep cards of a hand, as scored by the evaluator
+CardSet keepBest(const PokerHandEvaluator& peval, const CardSet& hand, size_t keep)
+{
+    if (keep >= hand.size())
+        return hand;
+    if (keep == 0)
+        return CardSet();
+
+    vector<Card> cards = hand.cards();
+    combinations c(cards.size(), keep);
+    CardSet best;
+    PokerEvaluation bestEval;
+    bool first = true;
+    do
+    {
+        CardSet sub;
+        for (size_t i = 0; i < keep; i++)
+            sub.insert(cards[c[i]]);
+        PokerEvaluation e = peval.evaluateHand(sub, CardSet()).high();
+        if (first || e > bestEval)
+        {
+            best = sub;
+            bestEval = e;
+            first = false;
+        }
+    } while (c.next());
+    return best;
+}
+
+// evaluates the final hands of a deal into a tally
+class Showdown
+{
+public:
+    Showdown(const PokerHandEvaluator& peval, size_t nplayers)
+        : _peval(peval)
+        , _split(peval.evaluationSize() == 2)
+        , _tally(nplayers)
+        , _high(nplayers)
+        , _low(nplayers)
+    {}
+
+    void add(const vector<CardSet>& hands)
+    {
+        for (size_t i = 0; i < hands.size(); i++)
+        {
+            PokerHandEvaluation eval = _peval.evaluateHand(hands[i], CardSet());
+            _high[i] = eval.eval(0).code();
+            if (_split)
+                _low[i] = eval.eval(1).code();
+        }
+        if (_split)
+            _tally.add(&_high[0], &_low[0]);
+        else
+            _tally.add(&_high[0]);
+    }
+
+    void flush(vector<EquityResult>& results, double weight)
+    {
+        _tally.flush(results, weight);
+    }
+
+private:
+    const PokerHandEvaluator& _peval;
+    bool _split;
+    ShowdownTally _tally;
+    vector<int> _high;
+    vector<int> _low;
+};
+
+// Every way to draw k cards of the given ranks, one representative card
+// per choice of counts, weighted by the number of ways to pick the suits.
+template <class F>
+void drawRanks(const vector<Card>* byRank,
+               size_t rank,
+               size_t k,
+               size_t available,
+               CardSet drawn,
+               double weight,
+               F& f)
+{
+    if (k == 0)
+    {
+        f(drawn, weight);
+        return;
+    }
+    if (rank == Rank::NUM_RANK || available < k)
+        return;
+
+    const vector<Card>& cards = byRank[rank];
+    size_t most = std::min(k, cards.size());
+    for (size_t c = 0; c <= most; c++)
+    {
+        if (c > 0)
+            drawn.insert(cards[c - 1]);
+        drawRanks(byRank, rank + 1, k - c, available - cards.size(), drawn,
+                  weight * choose(static_cast<int>(cards.size()), static_cast<int>(c)), f);
+    }
+}
+
+// Every way to draw k cards from live.  When suits do not matter the
+// draws are multisets of ranks with weights, otherwise sets of cards.
+template <class F>
+void forEachDraw(const CardSet& live, size_t k, bool ranks, F f)
+{
+    if (!ranks)
+    {
+        vector<Card> cards = live.cards();
+        combinations c(cards.size(), k);
+        do
+        {
+            CardSet drawn;
+            for (size_t i = 0; i < k; i++)
+                drawn.insert(cards[c[i]]);
+            f(drawn, 1.0);
+        } while (c.next());
+        return;
+    }
+
+    vector<Card> byRank[Rank::NUM_RANK];
+    for (const Card& card : live.cards())
+        byRank[card.rank().code()].push_back(card);
+    drawRanks(byRank, 0, k, live.size(), CardSet(), 1.0, f);
+}
+
+// The suit permutations which map the dead cards and each player's kept
+// cards onto themselves.  Deals related by one of these have the same
+// equities, since no evaluator prefers one suit to another.
+vector<std::array<int, Suit::NUM_SUIT>> suitSymmetries(const vector<DrawHand>& hands,
+                                                       const CardSet& dead)
+{
+    vector<std::array<int, Suit::NUM_SUIT>> symmetries;
+    std::array<int, Suit::NUM_SUIT> p = {{0, 1, 2, 3}};
+    do
+    {
+        bool fixed = dead.rotateSuits(p[0], p[1], p[2], p[3]) == dead;
+        for (size_t i = 0; fixed && i < hands.size(); i++)
+            fixed = hands[i].kept.rotateSuits(p[0], p[1], p[2], p[3]) == hands[i].kept;
+        if (fixed)
+            symmetries.push_back(p);
+    } while (std::next_permutation(p.begin(), p.end()));
+    return symmetries;
+}
+
+// state shared by the threads of one run
+struct SharedRun
+{
+    std::mutex mutex;
+    vector<EquityResult> results;
+    std::atomic<bool> stop;
+    uint64_t evaluations;
+    std::exception_ptr error;
+
+    // a monitor cancelled up front stops the run before any work
+    SharedRun(size_t nplayers, const EnumerationMonitor* monitor)
+        : results(nplayers)
+        , stop(monitor && monitor->cancelled())
+        , evaluations(0)
+    {}
+
+    // fold a worker's results and evaluation count in and publish,
+    // under the lock
+    void merge(vector<EquityResult>& local,
+               uint64_t& localEvaluations,
+               double fraction,
+               EnumerationMonitor* monitor)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (size_t i = 0; i < local.size(); i++)
+        {
+            results[i] += local[i];
+            local[i] = EquityResult();
+        }
+        evaluations += localEvaluations;
+        localEvaluations = 0;
+        if (monitor && !monitor->update(fraction, evaluations, results))
+            stop = true;
+    }
+
+    // normalize the equities, which stay zero if no work was merged
+    // before a cancel
+    vector<EquityResult>& finish()
+    {
+        double shares = 0.0;
+        for (EquityResult r : results)
+            shares += r.shares();
+        if (shares > 0.0)
+            EquityResult::normalize(results);
+        return results;
+    }
+
+    void fail()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!error)
+            error = std::current_exception();
+        stop = true;
+    }
+};
+
+// run the worker on each of n threads, rethrowing the first error
+template <class F>
+void runThreads(size_t n, SharedRun& run, F worker)
+{
+    auto guarded = [&]() {
+        try
+        {
+            worker();
+        }
+        catch (...)
+        {
+            run.fail();
+        }
+    };
+    vector<std::thread> threads;
+    for (size_t i = 1; i < n; i++)
+        threads.push_back(std::thread(guarded));
+    guarded();
+    for (std::thread& t : threads)
+        t.join();
+    if (run.error)
+        std::rethrow_exception(run.error);
+}
+
+// one thread's depth first walk over the deals
+class ExactDraw
+{
+public:
+    ExactDraw(const vector<DrawHand>& hands,
+              const PokerHandEvaluator& peval,
+              const CardSet& used,
+              bool ranks,
+              SharedRun& run,
+              EnumerationMonitor* monitor)
+        : _hands(hands)
+        , _peval(peval)
+        , _ranks(ranks)
+        , _rounds(countRounds(hands))
+        , _handSize(peval.handSize())
+        , _deck(fullDeck())
+        , _base(used)
+        , _used(used)
+        , _current(hands.size())
+        , _showdown(peval, hands.size())
+        , _results(hands.size())
+        , _run(run)
+        , _monitor(monitor)
+        , _leaves(0)
+        , _evaluations(0)
+    {}
+
+    // deal everything after the given first draw of player first
+    void dealFrom(size_t first, const CardSet& drawn, double weight)
+    {
+        _used = _base | drawn;
+        for (size_t i = 0; i < _hands.size(); i++)
+            _current[i] = _hands[i].kept;
+        if (first < _hands.size())
+            _current[first] |= drawn;
+        deal(0, first + 1, weight);
+
+        // walking cards, every deal under this first draw has its weight
+        _showdown.flush(_results, weight);
+    }
+
+    vector<EquityResult>& results() { return _results; }
+
+    // showdowns since the last merge
+    uint64_t& evaluations() { return _evaluations; }
+
+private:
+    void deal(size_t round, size_t player, double weight)
+    {
+        if (_run.stop)
+            return;
+        if (player >= _hands.size())
+        {
+            if (round + 1 < _rounds)
+                deal(round + 1, 0, weight);
+            else
+                showdown(weight);
+            return;
+        }
+
+        size_t k = drawsFor(_hands[player], round);
+        if (k == 0)
+        {
+            deal(round, player + 1, weight);
+            return;
+        }
+
+        CardSet saved = _current[player];
+        CardSet kept = (round > 0) ? keepBest(_peval, saved, _handSize - k) : saved;
+        forEachDraw(_deck ^ _used, k, _ranks, [&](const CardSet& drawn, double w) {
+            _current[player] = kept | drawn;
+            _used |= drawn;
+            deal(round, player + 1, weight * w);
+            _used ^= drawn;
+        });
+        _current[player] = saved;
+    }
+
+    void showdown(double weight)
+    {
+        _showdown.add(_current);
+        if (_ranks)
+            _showdown.flush(_results, weight);
+        _evaluations++;
+        if (++_leaves % kCheckInterval == 0 && _monitor && _monitor->cancelled())
+            _run.stop = true;
+    }
+
+    const vector<DrawHand>& _hands;
+    const PokerHandEvaluator& _peval;
+    bool _ranks;
+    size_t _rounds;
+    size_t _handSize;
+    CardSet _deck;
+    CardSet _base;
+    CardSet _used;
+    vector<CardSet> _current;
+    Showdown _showdown;
+    vector<EquityResult> _results;
+    SharedRun& _run;
+    EnumerationMonitor* _monitor;
+    uint64_t _leaves;
+    uint64_t _evaluations;
+};
+}  // namespace
+
+DrawEnumerator::DrawEnumerator()
+    : _dead()
+    , _threads(1)
+{}
+
+void DrawEnumerator::check(const vector<DrawHand>& hands,
+                           const PokerHandEvaluator& peval) const
+{
+    if (hands.empty())
+        throw runtime_error("DrawEnumerator, no hands");
+    if (hands.size() > ShowdownTally::MAX_PLAYERS)
+        throw runtime_error("DrawEnumerator, too many hands");
+    if (peval.boardSize() > 0)
+        throw runtime_error("DrawEnumerator, board games are not draw games");
+
+    size_t rounds = 0;
+    size_t drawn = 0;
+    CardSet used = _dead;
+    for (const DrawHand& h : hands)
+    {
+        if (used.intersects(h.kept))
+            throw runtime_error("DrawEnumerator, kept cards collide: " + h.kept.str());
+        used |= h.kept;
+        if (h.kept.size() + drawsFor(h, 0) != peval.handSize())
+            throw runtime_error("DrawEnumerator, hand does not add up to " +
+                                std::to_string(peval.handSize()) + " cards: " + h.kept.str());
+        for (size_t d : h.draws)
+        {
+            if (d > peval.handSize())
+                throw runtime_error("DrawEnumerator, too many cards drawn");
+            drawn += d;
+        }
+        rounds = std::max(rounds, h.draws.size());
+    }
+    if (peval.numDraws() > 0 && rounds > peval.numDraws())
+        throw runtime_error("DrawEnumerator, more draw rounds than the game has");
+    if (drawn > STANDARD_DECK_SIZE - used.size())
+        throw runtime_error("DrawEnumerator, not enough cards left to draw");
+}
+
+double DrawEnumerator::countDeals(const vector<DrawHand>& hands,
+                                  std::shared_ptr<PokerHandEvaluator> peval) const
+{
+    check(hands, *peval);
+    CardSet used = _dead;
+    for (const DrawHand& h : hands)
+        used |= h.kept;
+
+    double count = 1.0;
+    int remaining = static_cast<int>(STANDARD_DECK_SIZE - used.size());
+    size_t rounds = countRounds(hands);
+    for (size_t r = 0; r < rounds; r++)
+        for (const DrawHand& h : hands)
+        {
+            int k = static_cast<int>(drawsFor(h, r));
+            count *= choose(remaining, k);
+            remaining -= k;
+        }
+    return count;
+}
+
+vector<EquityResult>
+DrawEnumerator::calculateEquity(const vector<DrawHand>& hands,
+                                std::shared_ptr<PokerHandEvaluator> peval,
+                                EnumerationMonitor* monitor) const
+{
+    check(hands, *peval);
+    CardSet used = _dead;
+    for (const DrawHand& h : hands)
+        used |= h.kept;
+    bool ranks = !peval->usesSuits();
+
+    // the work units are the first draw of the first player who draws,
+    // and there is just one if nobody draws in the first round
+    size_t first = 0;
+    while (first < hands.size() && drawsFor(hands[first], 0) == 0)
+        first++;
+    vector<std::pair<CardSet, double>> units;
+    if (first < hands.size())
+        forEachDraw(fullDeck() ^ used, drawsFor(hands[first], 0), ranks,
+                    [&](const CardSet& drawn, double w) { units.push_back(std::make_pair(drawn, w)); });
+    else
+        units.push_back(std::make_pair(CardSet(), 1.0));
+
+    // with a single round, first draws which are the same up to a
+    // permutation of suits are walked once, with their combined weight.
+    // Later rounds are left alone, which cards are kept can depend on
+    // the order of the suits when two choices score the same.
+    if (!ranks && countRounds(hands) == 1 && first < hands.size())
+    {
+        vector<std::array<int, Suit::NUM_SUIT>> symmetries = suitSymmetries(hands, _dead);
+        if (symmetries.size() > 1)
+        {
+            std::map<CardSet, double> orbits;
+            for (const std::pair<CardSet, double>& unit : units)
+            {
+                CardSet canonical = unit.first;
+                for (const std::array<int, Suit::NUM_SUIT>& p : symmetries)
+                    canonical = std::min(canonical, unit.first.rotateSuits(p[0], p[1], p[2], p[3]));
+                orbits[canonical] += unit.second;
+            }
+            units.assign(orbits.begin(), orbits.end());
+        }
+    }
+
+    SharedRun run(hands.size(), monitor);
+    std::atomic<size_t> next(0);
+    std::atomic<size_t> done(0);
+    runThreads(std::min(_threads, units.size()), run, [&]() {
+        ExactDraw walk(hands, *peval, used, ranks, run, monitor);
+        for (size_t u = next++; u < units.size() && !run.stop; u = next++)
+        {
+            walk.dealFrom(first, units[u].first, units[u].second);
+            run.merge(walk.results(), walk.evaluations(),
+                      static_cast<double>(++done) / units.size(), monitor);
+        }
+    });
+
+    return run.finish();
+}
+
+vector<EquityResult>
+DrawEnumerator::sampleEquity(const vector<DrawHand>& hands,
+                             std::shared_ptr<PokerHandEvaluator> peval,
+                             uint64_t trials,
+                             unsigned int seed,
+                             EnumerationMonitor* monitor) const
+{
+    check(hands, *peval);
+    CardSet used = _dead;
+    for (const DrawHand& h : hands)
+        used |= h.kept;
+    vector<Card> live = CardSet(fullDeck() ^ used).cards();
+    size_t rounds = countRounds(hands);
+    size_t handSize = peval->handSize();
+
+    uint64_t nchunks = (trials + kChunkTrials - 1) / kChunkTrials;
+    SharedRun run(hands.size(), monitor);
+    std::atomic<uint64_t> next(0);
+    std::atomic<uint64_t> done(0);
+    runThreads(std::min<uint64_t>(_threads, std::max<uint64_t>(nchunks, 1)), run, [&]() {
+        Showdown showdown(*peval, hands.size());
+        vector<EquityResult> results(hands.size());
+        vector<CardSet> current(hands.size());
+        vector<Card> deck(live.size());
+        for (uint64_t c = next++; c < nchunks && !run.stop; c = next++)
+        {
+            // each chunk has its own generator, so the deals do not
+            // depend on which thread runs it
+            std::seed_seq seq = {seed, static_cast<unsigned int>(c), static_cast<unsigned int>(c >> 32)};
+            std::mt19937 rng(seq);
+            uint64_t end = std::min(trials, (c + 1) * kChunkTrials);
+            for (uint64_t t = c * kChunkTrials; t < end; t++)
+            {
+                std::copy(live.begin(), live.end(), deck.begin());
+                size_t nlive = deck.size();
+                for (size_t i = 0; i < hands.size(); i++)
+                    current[i] = hands[i].kept;
+                for (size_t r = 0; r < rounds; r++)
+                    for (size_t i = 0; i < hands.size(); i++)
+                    {
+                        size_t k = drawsFor(hands[i], r);
+                        if (k == 0)
+                            continue;
+                        if (r > 0)
+                            current[i] = keepBest(*peval, current[i], handSize - k);
+                        for (size_t j = 0; j < k; j++)
+                        {
+                            std::uniform_int_distribution<size_t> pick(0, nlive - 1);
+                            size_t p = pick(rng);
+                            current[i].insert(deck[p]);
+                            std::swap(deck[p], deck[--nlive]);
+                        }
+                    }
+                showdown.add(current);
+            }
+            uint64_t evaluations = end - c * kChunkTrials;
+            showdown.flush(results, 1.0);
+            if (monitor && monitor->cancelled())
+                run.stop = true;
+            run.merge(results, evaluations, static_cast<double>(++done) / nchunks, monitor);
+        }
+    });
+
+    return run.finish();
+}
+
+}  // namespace pokerstove
@@ -0,0 +1,112 @@
+/**
+ * Copyright (c) 2012 Andrew Prock. All rights reserved.
+ */
+#ifndef PENUM_DRAWENUMERATOR_H_
+#define PENUM_DRAWENUMERATOR_H_
+
+#include <memory>
+#include <vector>
+#include <pokerstove/peval/CardSet.h>
+#include <pokerstove/peval/PokerHandEvaluator.h>
+
+namespace pokerstove
+{
+class EnumerationMonitor;
+
+/**
+ * A player in a draw game: the cards they keep, and the number of cards
+ * they draw in each of the draw rounds still to come.  A player who
+ * stands pat has no draws, or draws of zero.
+ */
+struct DrawHand
+{
+    CardSet kept;
+    std::vector<size_t> draws;
+
+    DrawHand()
+        : kept()
+        , draws()
+    {}
+
+    DrawHand(const CardSet& k, const std::vector<size_t>& d)
+        : kept(k)
+        , draws(d)
+    {}
+};
+
+/**
+ * Equity for the draw games, five card draw, 2-7 and badugi.  Each
+ * player keeps some cards and draws replacements from what is left of
+ * the deck, once per draw round.  Every card which is kept, drawn,
+ * discarded, or given as dead is out of the deck for the rest of the
+ * hand, discards are not reshuffled.
+ *
+ * In the first round a player draws to their kept cards.  In later
+ * rounds a player drawing n cards keeps the best handSize-n cards of
+ * their current hand, as scored by the evaluator, and draws to those.
+ *
+ * calculateEquity visits every deal of the replacement cards.  If the
+ * evaluator does not use suits, draws are enumerated as multisets of
+ * ranks with a weight for the number of ways to pick the suits, which
+ * is much smaller than enumerating the cards.  Otherwise first draws
+ * which differ only by a permutation of suits that leaves every known
+ * card in place are walked once.  sampleEquity deals a fixed number
+ * of random runouts instead, for deals which are too big to enumerate.
+ *
+ * Both spread the work over setThreads() threads, and stop early,
+ * returning the results so far, if the monitor is cancelled.  Results
+ * cancelled before any work is counted have zero shares and equity.
+ */
+class DrawEnumerator
+{
+public:
+    DrawEnumerator();
+
+    /**
+     * cards known to be out of the deck, exposed discards for example
+     */
+    void setDead(const CardSet& dead) { _dead = dead; }
+    const CardSet& dead() const { return _dead; }
+
+    void setThreads(size_t threads) { _threads = threads > 0 ? threads : 1; }
+    size_t threads() const { return _threads; }
+
+    /**
+     * The number of card deals calculateEquity would visit if it
+     * enumerated cards, before any reduction by ranks.
+     */
+    double countDeals(const std::vector<DrawHand>& hands,
+                      std::shared_ptr<PokerHandEvaluator> peval) const;
+
+    /**
+     * Exact equity over every deal of the replacement cards.  Throws a
+     * runtime_error if the hands are not valid for the game or there are
+     * not enough cards left to draw from.
+     */
+    std::vector<EquityResult>
+    calculateEquity(const std::vector<DrawHand>& hands,
+                    std::shared_ptr<PokerHandEvaluator> peval,
+                    EnumerationMonitor* monitor = NULL) const;
+
+    /**
+     * Equity over the given number of random deals.  The deals only
+     * depend on the seed, not on the number of threads.
+     */
+    std::vector<EquityResult>
+    sampleEquity(const std::vector<DrawHand>& hands,
+                 std::shared_ptr<PokerHandEvaluator> peval,
+                 uint64_t trials,
+                 unsigned int seed = 0,
+                 EnumerationMonitor* monitor = NULL) const;
+
+private:
+    void check(const std::vector<DrawHand>& hands,
+               const PokerHandEvaluator& peval) const;
+
+    CardSet _dead;
+    size_t _threads;
+};
+
+}  // namespace pokerstove
+
+#endif  // PENUM_DRAWENUMERATOR_H_
@@ -0,0 +1,170 @@
+#include "DrawEnumerator.h"
+#include "EnumerationMonitor.h"
+#include <cmath>
+#include <stdexcept>
+#include <pokerstove/peval/Card.h>
+#include <pokerstove/peval/DeuceToSevenHandEvaluator.h>
+#include <gtest/gtest.h>
+
+using namespace pokerstove;
+using namespace std;
+
+namespace
+{
+vector<DrawHand> oneDrawVsPat()
+{
+    vector<DrawHand> hands;
+    hands.push_back(DrawHand(CardSet("2c3d4h8s9c"), vector<size_t>()));
+    hands.push_back(DrawHand(CardSet("2d3h4s7c"), vector<size_t>(1, 1)));
+    return hands;
+}
+}  // namespace
+
+TEST(DrawEnumerator, OneCardDrawVsPat)
+{
+    std::shared_ptr<PokerHandEvaluator> peval = PokerHandEvaluator::alloc("k");
+    vector<DrawHand> hands = oneDrawVsPat();
+
+    // every live card, by hand
+    CardSet deck;
+    deck.fill();
+    CardSet live = deck ^ hands[0].kept ^ hands[1].kept;
+    double wins = 0.0, ties = 0.0;
+    for (const Card& c : live.cards())
+    {
+        CardSet drawn(c);
+        PokerEvaluation pat = peval->evaluateHand(hands[0].kept, CardSet()).high();
+        PokerEvaluation draw = peval->evaluateHand(hands[1].kept | drawn, CardSet()).high();
+        if (draw > pat)
+            wins += 1.0;
+        else if (draw == pat)
+            ties += 1.0;
+    }
+
+    DrawEnumerator draws;
+    EXPECT_EQ(live.size(), draws.countDeals(hands, peval));
+    vector<EquityResult> results = draws.calculateEquity(hands, peval);
+    ASSERT_EQ(2, results.size());
+    EXPECT_NEAR((wins + ties / 2) / live.size(), results[1].equity, 1e-9);
+    EXPECT_NEAR(1.0, results[0].equity + results[1].equity, 1e-9);
+}
+
+TEST(DrawEnumerator, RanksMatchCards)
+{
+    // A-5 lowball does not care about suits, so both walks must agree
+    std::shared_ptr<PokerHandEvaluator> ranks = PokerHandEvaluator::alloc("l");
+    std::shared_ptr<PokerHandEvaluator> cards = PokerHandEvaluator::alloc("l");
+    ASSERT_FALSE(ranks->usesSuits());
+    cards->useSuits(true);
+
+    vector<DrawHand> hands;
+    hands.push_back(DrawHand(CardSet("As2c3d"), vector<size_t>(1, 2)));
+    hands.push_back(DrawHand(CardSet("Ah2h4s7c"), vector<size_t>(1, 1)));
+    hands.push_back(DrawHand(CardSet("3s4d5c6h8d"), vector<size_t>()));
+
+    DrawEnumerator draws;
+    draws.setDead(CardSet("KcKd"));
+    vector<EquityResult> fast = draws.calculateEquity(hands, ranks);
+    vector<EquityResult> slow = draws.calculateEquity(hands, cards);
+    for (size_t i = 0; i < hands.size(); i++)
+    {
+        EXPECT_NEAR(slow[i].winShares, fast[i].winShares, 1e-9);
+        EXPECT_NEAR(slow[i].tieShares, fast[i].tieShares, 1e-9);
+    }
+}
+
+TEST(DrawEnumerator, ThreadsDoNotChangeResults)
+{
+    std::shared_ptr<PokerHandEvaluator> peval(new DeuceToSevenHandEvaluator);
+    vector<DrawHand> hands;
+    hands.push_back(DrawHand(CardSet("2c3d4h"), vector<size_t>(1, 2)));
+    hands.push_back(DrawHand(CardSet("2d3h5s7c"), vector<size_t>(1, 1)));
+
+    DrawEnumerator one;
+    DrawEnumerator four;
+    four.setThreads(4);
+    EnumerationMonitor ma, mb;
+    vector<EquityResult> a = one.calculateEquity(hands, peval, &ma);
+    vector<EquityResult> b = four.calculateEquity(hands, peval, &mb);
+    for (size_t i = 0; i < hands.size(); i++)
+        EXPECT_NEAR(a[i].equity, b[i].equity, 1e-9);
+    EXPECT_GT(ma.evaluations(), 0);
+    EXPECT_EQ(ma.evaluations(), mb.evaluations());
+
+    EnumerationMonitor mc, md;
+    vector<EquityResult> c = one.sampleEquity(hands, peval, 20000, 7, &mc);
+    vector<EquityResult> d = four.sampleEquity(hands, peval, 20000, 7, &md);
+    for (size_t i = 0; i < hands.size(); i++)
+        EXPECT_DOUBLE_EQ(c[i].equity, d[i].equity);
+    EXPECT_EQ(20000, mc.evaluations());
+    EXPECT_EQ(20000, md.evaluations());
+}
+
+TEST(DrawEnumerator, SamplingMatchesExact)
+{
+    std::shared_ptr<PokerHandEvaluator> peval = PokerHandEvaluator::alloc("T");
+    vector<DrawHand> hands;
+    vector<size_t> twice(2, 1);
+    hands.push_back(DrawHand(CardSet("Ac2d3h4s"), twice));
+    hands.push_back(DrawHand(CardSet("As2h3c5d6c"), vector<size_t>()));
+
+    DrawEnumerator draws;
+    draws.setThreads(2);
+    double n = STANDARD_DECK_SIZE - 9;
+    EXPECT_EQ(n * (n - 1), draws.countDeals(hands, peval));
+    vector<EquityResult> exact = draws.calculateEquity(hands, peval);
+    vector<EquityResult> sampled = draws.sampleEquity(hands, peval, 100000, 3);
+    for (size_t i = 0; i < hands.size(); i++)
+        EXPECT_NEAR(exact[i].equity, sampled[i].equity, 0.01);
+}
+
+TEST(DrawEnumerator, Cancel)
+{
+    std::shared_ptr<PokerHandEvaluator> peval(new DeuceToSevenHandEvaluator);
+    vector<DrawHand> hands;
+    hands.push_back(DrawHand(CardSet("2c"), vector<size_t>(1, 4)));
+    hands.push_back(DrawHand(CardSet("2d"), vector<size_t>(1, 4)));
+
+    EnumerationMonitor monitor;
+    monitor.cancel();
+    DrawEnumerator draws;
+    vector<EquityResult> results = draws.calculateEquity(hands, peval, &monitor);
+    ASSERT_EQ(2, results.size());
+    for (EquityResult r : results)
+    {
+        EXPECT_EQ(0.0, r.shares());
+        EXPECT_EQ(0.0, r.equity);
+    }
+
+    results = draws.sampleEquity(hands, peval, 100000, 1, &monitor);
+    ASSERT_EQ(2, results.size());
+    for (EquityResult r : results)
+    {
+        EXPECT_EQ(0.0, r.shares());
+        EXPECT_FALSE(std::isnan(r.equity));
+    }
+}
+
+TEST(DrawEnumerator, InvalidHands)
+{
+    std::shared_ptr<PokerHandEvaluator> peval(new DeuceToSevenHandEvaluator);
+    DrawEnumerator draws;
+
+    vector<DrawHand> collide;
+    collide.push_back(DrawHand(CardSet("2c3d4h"), vector<size_t>(1, 2)));
+    collide.push_back(DrawHand(CardSet("2c5s7h"), vector<size_t>(1, 2)));
+    EXPECT_THROW(draws.calculateEquity(collide, peval), runtime_error);
+
+    vector<DrawHand> size;
+    size.push_back(DrawHand(CardSet("2c3d4h"), vector<size_t>(1, 1)));
+    EXPECT_THROW(draws.calculateEquity(size, peval), runtime_error);
+
+    // the evaluator is set up for a single draw
+    peval->setNumDraws(1);
+    vector<DrawHand> rounds = oneDrawVsPat();
+    rounds[1].draws.push_back(1);
+    EXPECT_THROW(draws.calculateEquity(rounds, peval), runtime_error);
+
+    draws.setDead(CardSet("7c"));
+    EXPECT_THROW(draws.calculateEquity(oneDrawVsPat(), peval), runtime_error);
+}
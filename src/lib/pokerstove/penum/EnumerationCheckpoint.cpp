@@ -0,0 +1,48 @@
+/**
+ * Copyright (c) 2012 Andrew Prock. All rights reserved.
+ */
+#include "EnumerationCheckpoint.h"
+
+#include <cstdio>
+
+using namespace std;
+
+namespace pokerstove
+{
+
+EnumerationCheckpoint::EnumerationCheckpoint(const string& filename, double interval)
+    : _filename(filename)
+    , _interval(interval)
+    , _last(chrono::steady_clock::now())
+    , _saves(0)
+{}
+
+bool EnumerationCheckpoint::due() const
+{
+    chrono::duration<double> d = chrono::steady_clock::now() - _last;
+    return d.count() >= _interval;
+}
+
+bool EnumerationCheckpoint::save(const PartialEquity& part)
+{
+    string tmp = _filename + ".tmp";
+    if (!part.save(tmp))
+    {
+        remove(tmp.c_str());
+        return false;
+    }
+#ifdef WIN32
+    // rename does not replace an existing file here
+    remove(_filename.c_str());
+#endif
+    if (rename(tmp.c_str(), _filename.c_str()) != 0)
+    {
+        remove(tmp.c_str());
+        return false;
+    }
+    _last = chrono::steady_clock::now();
+    _saves++;
+    return true;
+}
+
+}  // namespace pokerstove
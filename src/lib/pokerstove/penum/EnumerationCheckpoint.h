@@ -0,0 +1,57 @@
+/**
+ * Copyright (c) 2012 Andrew Prock. All rights reserved.
+ */
+#ifndef PENUM_ENUMERATIONCHECKPOINT_H_
+#define PENUM_ENUMERATIONCHECKPOINT_H_
+
+#include <chrono>
+#include <string>
+#include "PartialEquity.h"
+
+namespace pokerstove
+{
+/**
+ * A file which a long enumeration saves its progress to every so often,
+ * so that it can be resumed after the process dies.  The progress is
+ * stored as a PartialEquity, the showdowns covered so far and the
+ * results accumulated over them, which is everything needed to continue
+ * with ShowdownEnumerator::resumePartialEquity.
+ *
+ * Saves go to a temporary file which is then renamed over the
+ * checkpoint, so a process killed in the middle of a save leaves the
+ * previous checkpoint intact.
+ */
+class EnumerationCheckpoint
+{
+public:
+    /**
+     * save to filename at most once every interval seconds
+     */
+    explicit EnumerationCheckpoint(const std::string& filename, double interval = 60.0);
+
+    const std::string& filename() const { return _filename; }
+    double interval() const { return _interval; }
+
+    /**
+     * true if the interval has passed since the last save
+     */
+    bool due() const;
+
+    bool save(const PartialEquity& part);
+    bool load(PartialEquity& part) const { return part.load(_filename); }
+
+    /**
+     * number of times the checkpoint has been saved
+     */
+    size_t saves() const { return _saves; }
+
+private:
+    std::string _filename;
+    double _interval;
+    std::chrono::steady_clock::time_point _last;
+    size_t _saves;
+};
+
+}  // namespace pokerstove
+
+#endif  // PENUM_ENUMERATIONCHECKPOINT_H_
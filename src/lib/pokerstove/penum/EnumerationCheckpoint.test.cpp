@@ -0,0 +1,61 @@
+#include "EnumerationCheckpoint.h"
+#include "EnumerationMonitor.h"
+#include "RangeDistribution.h"
+#include "ShowdownEnumerator.h"
+#include <cstdio>
+#include <gtest/gtest.h>
+
+using namespace pokerstove;
+using namespace std;
+
+TEST(EnumerationCheckpoint, StopAndResume)
+{
+    std::shared_ptr<PokerHandEvaluator> peval = PokerHandEvaluator::alloc("h");
+    RangeDistribution a, b;
+    ASSERT_TRUE(a.parse("QQ+,AK"));
+    ASSERT_TRUE(b.parse("JJ,AQs"));
+    vector<CardDistribution> dists;
+    dists.push_back(a.data());
+    dists.push_back(b.data());
+    dists.push_back(CardDistribution(CardSet("9h8h")));
+    CardSet board("Ts7h2c");
+
+    ShowdownEnumerator showdown;
+    vector<ExactEquityResult> expected =
+        showdown.calculateExactEquity(dists, board, peval);
+
+    // a cancelled run stops at its first progress update, and saves
+    // what it has done
+    string filename = ::testing::TempDir() + "checkpoint.pspe";
+    EnumerationCheckpoint checkpoint(filename, 0.0);
+    EnumerationMonitor monitor;
+    monitor.cancel();
+    PartialEquity part = showdown.calculatePartialEquity(
+        dists, board, peval, 0, ShowdownEnumerator::ALL_SHOWDOWNS, true,
+        &monitor, &checkpoint);
+    EXPECT_GT(part.covered(), 0);
+    EXPECT_FALSE(part.complete());
+    EXPECT_GT(checkpoint.saves(), 0);
+
+    PartialEquity saved;
+    ASSERT_TRUE(checkpoint.load(saved));
+    EXPECT_EQ(part.ranges(), saved.ranges());
+    for (size_t i = 0; i < part.size(); i++)
+        EXPECT_EQ(part.exactResults()[i], saved.exactResults()[i]);
+
+    // resuming from the file finishes with exactly the full result
+    showdown.resumePartialEquity(saved, dists, board, peval, 0,
+                                 ShowdownEnumerator::ALL_SHOWDOWNS, NULL, &checkpoint);
+    EXPECT_TRUE(saved.complete());
+    for (size_t i = 0; i < expected.size(); i++)
+        EXPECT_EQ(expected[i], saved.exactResults()[i]);
+
+    PartialEquity last;
+    ASSERT_TRUE(checkpoint.load(last));
+    EXPECT_TRUE(last.complete());
+    remove(filename.c_str());
+
+    // a checkpoint of another enumeration is refused
+    dists[2] = CardDistribution(CardSet("9h7d"));
+    EXPECT_THROW(showdown.resumePartialEquity(last, dists, board, peval), runtime_error);
+}
@@ -0,0 +1,47 @@
+/**
+ * Copyright (c) 2012 Andrew Prock. All rights reserved.
+ */
+#include "EnumerationMonitor.h"
+
+using namespace std;
+
+namespace pokerstove
+{
+
+EnumerationMonitor::EnumerationMonitor()
+    : _cancelled(false)
+    , _fraction(0.0)
+    , _evaluations(0)
+    , _mutex()
+    , _results()
+{}
+
+vector<EquityResult> EnumerationMonitor::results() const
+{
+    lock_guard<mutex> lock(_mutex);
+    return _results;
+}
+
+bool EnumerationMonitor::update(double fraction,
+                                uint64_t evaluations,
+                                const vector<EquityResult>& results)
+{
+    {
+        lock_guard<mutex> lock(_mutex);
+        _results = results;
+    }
+    _fraction = fraction;
+    _evaluations = evaluations;
+    return !_cancelled;
+}
+
+void EnumerationMonitor::reset()
+{
+    lock_guard<mutex> lock(_mutex);
+    _results.clear();
+    _cancelled = false;
+    _fraction = 0.0;
+    _evaluations = 0;
+}
+
+}  // namespace pokerstove
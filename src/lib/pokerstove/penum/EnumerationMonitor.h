@@ -0,0 +1,71 @@
+/**
+ * Copyright (c) 2012 Andrew Prock. All rights reserved.
+ */
+#ifndef PENUM_ENUMERATIONMONITOR_H_
+#define PENUM_ENUMERATIONMONITOR_H_
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include <pokerstove/peval/PokerHandEvaluator.h>
+
+namespace pokerstove
+{
+/**
+ * Shared state between a running enumeration and the threads which watch
+ * it.  The enumerator publishes its progress and a snapshot of the
+ * results every so often, and checks for cancellation at the same time,
+ * so observers never touch the enumerator's working state.
+ */
+class EnumerationMonitor
+{
+public:
+    EnumerationMonitor();
+
+    /**
+     * ask the enumeration to stop at its next checkpoint
+     */
+    void cancel() { _cancelled = true; }
+    bool cancelled() const { return _cancelled; }
+
+    /**
+     * fraction of the enumeration space covered so far, [0,1]
+     */
+    double fraction() const { return _fraction; }
+
+    /**
+     * number of showdowns evaluated so far
+     */
+    uint64_t evaluations() const { return _evaluations; }
+
+    /**
+     * the results accumulated as of the last update
+     */
+    std::vector<EquityResult> results() const;
+
+    /**
+     * called by the enumerator, returns false if it should stop
+     */
+    bool update(double fraction,
+                uint64_t evaluations,
+                const std::vector<EquityResult>& results);
+
+    void reset();
+
+private:
+    // non-copyable
+    EnumerationMonitor(const EnumerationMonitor&);
+    EnumerationMonitor& operator=(const EnumerationMonitor&);
+
+    std::atomic<bool> _cancelled;
+    std::atomic<double> _fraction;
+    std::atomic<uint64_t> _evaluations;
+
+    mutable std::mutex _mutex;
+    std::vector<EquityResult> _results;
+};
+
+}  // namespace pokerstove
+
+#endif  // PENUM_ENUMERATIONMONITOR_H_
@@ -0,0 +1,94 @@
+/**
+ * Copyright (c) 2012 Andrew Prock. All rights reserved.
+ */
+#include "EnumerationStats.h"
+
+#include <boost/format.hpp>
+
+using namespace std;
+
+namespace pokerstove
+{
+
+namespace
+{
+double percent(uint64_t part, uint64_t whole)
+{
+    return (whole > 0) ? 100.0 * part / whole : 0.0;
+}
+}  // namespace
+
+EnumerationStats::EnumerationStats()
+{
+    clear();
+}
+
+bool EnumerationStats::enabled()
+{
+#ifdef POKERSTOVE_STATS
+    return true;
+#else
+    return false;
+#endif
+}
+
+void EnumerationStats::clear()
+{
+    odometerSteps = 0;
+    disjointRejects = 0;
+    partitions = 0;
+    showdowns = 0;
+    ties = 0;
+    splitPots = 0;
+    wallSeconds = 0.0;
+    cpuSeconds = 0.0;
+    evaluations.clear();
+}
+
+uint64_t EnumerationStats::totalEvaluations() const
+{
+    uint64_t total = 0;
+    for (const pair<const string, uint64_t>& e : evaluations)
+        total += e.second;
+    return total;
+}
+
+EnumerationStats& EnumerationStats::operator+=(const EnumerationStats& other)
+{
+    odometerSteps += other.odometerSteps;
+    disjointRejects += other.disjointRejects;
+    partitions += other.partitions;
+    showdowns += other.showdowns;
+    ties += other.ties;
+    splitPots += other.splitPots;
+    wallSeconds += other.wallSeconds;
+    cpuSeconds += other.cpuSeconds;
+    for (const pair<const string, uint64_t>& e : other.evaluations)
+        evaluations[e.first] += e.second;
+    return *this;
+}
+
+string EnumerationStats::str() const
+{
+    uint64_t evals = totalEvaluations();
+    string ret;
+    ret += (boost::format("odometer steps:   %d\n") % odometerSteps).str();
+    ret += (boost::format("disjoint rejects: %d (%.1f%%)\n") % disjointRejects
+            % percent(disjointRejects, disjointRejects + odometerSteps)).str();
+    ret += (boost::format("partitions:       %d\n") % partitions).str();
+    ret += (boost::format("showdowns:        %d\n") % showdowns).str();
+    ret += (boost::format("ties:             %d (%.1f%%)\n") % ties
+            % percent(ties, showdowns)).str();
+    ret += (boost::format("split pots:       %d (%.1f%%)\n") % splitPots
+            % percent(splitPots, showdowns)).str();
+    ret += (boost::format("evaluations:      %d\n") % evals).str();
+    for (const pair<const string, uint64_t>& e : evaluations)
+        ret += (boost::format("  %-15s %d\n") % (e.first + ":") % e.second).str();
+    ret += (boost::format("wall time:        %.3fs\n") % wallSeconds).str();
+    ret += (boost::format("cpu time:         %.3fs\n") % cpuSeconds).str();
+    ret += (boost::format("evals/sec:        %.4g\n")
+            % (wallSeconds > 0.0 ? evals / wallSeconds : 0.0)).str();
+    return ret;
+}
+
+}  // namespace pokerstove
@@ -0,0 +1,67 @@
+/**
+ * Copyright (c) 2012 Andrew Prock. All rights reserved.
+ */
+#ifndef PENUM_ENUMERATIONSTATS_H_
+#define PENUM_ENUMERATIONSTATS_H_
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+/**
+ * Statistics are only gathered when the library is built with
+ * POKERSTOVE_STATS defined (cmake -DPOKERSTOVE_STATS=ON).  Otherwise the
+ * counting code is compiled out of the inner loops and the stats stay
+ * empty.
+ */
+#ifdef POKERSTOVE_STATS
+#define PENUM_STAT(x) x
+#else
+#define PENUM_STAT(x)
+#endif
+
+namespace pokerstove
+{
+/**
+ * Counters describing where an enumeration spent its time.  A high
+ * share of disjoint rejects means the distributions overlap heavily and
+ * most hands picked are filtered out by the DisjointOdometer, while a
+ * high evaluation count per odometer step means the time goes into
+ * dealing and evaluating.
+ */
+struct EnumerationStats
+{
+    uint64_t odometerSteps;    //!< disjoint hand combinations visited
+    uint64_t disjointRejects;  //!< hands filtered for sharing cards
+    uint64_t partitions;       //!< PartitionEnumerator2 steps, with those skipping to a slice
+    uint64_t showdowns;        //!< deals evaluated and tallied
+    uint64_t ties;             //!< showdowns where some pot was tied
+    uint64_t splitPots;        //!< showdowns with a low half, nevals == 2
+    double wallSeconds;
+    double cpuSeconds;
+
+    //!< evaluateHand calls, by evaluator id
+    std::map<std::string, uint64_t> evaluations;
+
+    EnumerationStats();
+
+    /**
+     * true if the library was built to gather statistics
+     */
+    static bool enabled();
+
+    void clear();
+
+    uint64_t totalEvaluations() const;
+
+    EnumerationStats& operator+=(const EnumerationStats& other);
+
+    /**
+     * multi-line report, one counter per line
+     */
+    std::string str() const;
+};
+
+}  // namespace pokerstove
+
+#endif  // PENUM_ENUMERATIONSTATS_H_
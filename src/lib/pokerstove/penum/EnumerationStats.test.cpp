@@ -0,0 +1,102 @@
+#include "EnumerationStats.h"
+#include "RangeDistribution.h"
+#include "ShowdownEnumerator.h"
+#include <gtest/gtest.h>
+
+using namespace pokerstove;
+using namespace std;
+
+TEST(EnumerationStats, Holdem)
+{
+    std::shared_ptr<PokerHandEvaluator> peval = PokerHandEvaluator::alloc("h");
+    RangeDistribution aces, aceKing;
+    ASSERT_TRUE(aces.parse("AA"));
+    ASSERT_TRUE(aceKing.parse("AKs"));
+    vector<CardDistribution> dists;
+    dists.push_back(aces.data());
+    dists.push_back(aceKing.data());
+
+    EnumerationStats stats;
+    ShowdownEnumerator showdown;
+    showdown.calculateEquity(dists, CardSet("2c7h9s"), peval, NULL, &stats);
+    if (!EnumerationStats::enabled())
+    {
+        EXPECT_EQ(0, stats.odometerSteps);
+        EXPECT_EQ(0, stats.totalEvaluations());
+        return;
+    }
+
+    // each AA shares an ace with two of the four AKs, which are filtered
+    // before the tuple is visited
+    EXPECT_EQ(12, stats.odometerSteps);
+    EXPECT_EQ(12, stats.disjointRejects);
+    EXPECT_EQ(12 * 990, stats.partitions);
+    EXPECT_EQ(12 * 990, stats.showdowns);
+    EXPECT_EQ(2 * 12 * 990, stats.evaluations["h"]);
+    EXPECT_EQ(0, stats.splitPots);
+    EXPECT_GT(stats.wallSeconds, 0.0);
+}
+
+TEST(EnumerationStats, SplitPots)
+{
+    std::shared_ptr<PokerHandEvaluator> peval = PokerHandEvaluator::alloc("o8");
+    vector<CardDistribution> dists;
+    dists.push_back(CardDistribution(CardSet("Ac2c3dKd")));
+    dists.push_back(CardDistribution(CardSet("QhQsJhTs")));
+
+    EnumerationStats stats;
+    ShowdownEnumerator showdown;
+    showdown.calculateEquity(dists, CardSet("4h5s9c"), peval, NULL, &stats);
+    if (!EnumerationStats::enabled())
+        return;
+
+    EXPECT_EQ(1, stats.odometerSteps);
+    EXPECT_GT(stats.splitPots, 0);
+    EXPECT_LT(stats.splitPots, stats.showdowns);
+    EXPECT_LE(stats.ties, stats.showdowns);
+}
+
+TEST(EnumerationStats, WorkUnits)
+{
+    // a partial result resumed in two pieces counts every showdown once
+    std::shared_ptr<PokerHandEvaluator> peval = PokerHandEvaluator::alloc("h");
+    vector<CardDistribution> dists;
+    dists.push_back(CardDistribution(CardSet("AcAd")));
+    dists.push_back(CardDistribution(CardSet("KhKs")));
+    CardSet board("2c7h9s");
+
+    EnumerationStats stats;
+    ShowdownEnumerator showdown;
+    PartialEquity part =
+        showdown.calculatePartialEquity(dists, board, peval, 0, 400, false,
+                                        NULL, NULL, &stats);
+    showdown.resumePartialEquity(part, dists, board, peval, 0,
+                                 ShowdownEnumerator::ALL_SHOWDOWNS, NULL, NULL,
+                                 &stats);
+    ASSERT_TRUE(part.complete());
+    if (!EnumerationStats::enabled())
+        return;
+
+    EXPECT_EQ(part.total(), stats.showdowns);
+    EXPECT_EQ(2 * part.total(), stats.evaluations["h"]);
+
+    // the second piece steps the partitions over the first 400 deals
+    // before it starts evaluating
+    EXPECT_EQ(part.total() + 400, stats.partitions);
+}
+
+TEST(EnumerationStats, Accumulate)
+{
+    EnumerationStats a, b;
+    a.odometerSteps = 3;
+    a.evaluations["h"] = 10;
+    b.odometerSteps = 4;
+    b.evaluations["h"] = 5;
+    b.evaluations["o"] = 1;
+    a += b;
+    EXPECT_EQ(7, a.odometerSteps);
+    EXPECT_EQ(16, a.totalEvaluations());
+    EXPECT_NE(string::npos, a.str().find("odometer steps"));
+    a.clear();
+    EXPECT_EQ(0, a.totalEvaluations());
+}
@@ -0,0 +1,272 @@
+/**
+ * Copyright (c) 2012 Andrew Prock. All rights reserved.
+ */
+#include "EquityHistogram.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <set>
+#include <thread>
+#include "EquityTable.h"
+#include <pokerstove/peval/Card.h>
+#include <pokerstove/util/combinations.h>
+
+using namespace std;
+
+namespace pokerstove
+{
+
+namespace
+{
+const char kMagic[4] = {'P', 'S', 'E', 'H'};
+const uint32_t kVersion = 1;
+const size_t kFullBoard = 5;
+const size_t kBlock = 16;  // boards per thread between writes
+
+struct HistogramHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t boardSize;
+    uint32_t numBoards;
+    uint32_t bins;
+};
+
+/**
+ * The histograms of every pocket on one flop or turn.  Shares and
+ * opponent weights are summed by next street card over every runout to
+ * the river, then binned.
+ */
+void boardHistograms(const CardSet& board,
+                     size_t bins,
+                     const vector<double>& weights,
+                     uint8_t* counts)
+{
+    const size_t npockets = EquityTable::NUM_POCKETS;
+    vector<double> shares(STANDARD_DECK_SIZE * npockets, 0.0);
+    vector<double> opponents(STANDARD_DECK_SIZE * npockets, 0.0);
+    vector<double> riverShares;
+    vector<double> riverOpponents;
+
+    vector<uint8_t> live;
+    for (uint8_t c = 0; c < STANDARD_DECK_SIZE; c++)
+        if (!board.contains(Card(c)))
+            live.push_back(c);
+
+    combinations runout(live.size(), kFullBoard - board.size());
+    do
+    {
+        CardSet full = board;
+        for (size_t i = 0; i < runout.size(); i++)
+            full.insert(Card(live[runout[i]]));
+        EquityTable::riverShares(full, weights, riverShares, riverOpponents);
+        for (size_t i = 0; i < runout.size(); i++)
+        {
+            size_t next = live[runout[i]] * npockets;
+            for (size_t p = 0; p < npockets; p++)
+            {
+                shares[next + p] += riverShares[p];
+                opponents[next + p] += riverOpponents[p];
+            }
+        }
+    } while (runout.next());
+
+    // pockets holding the next card, or blocking the whole range, have
+    // no opponents there
+    memset(counts, 0, npockets * bins);
+    for (uint8_t c : live)
+        for (size_t p = 0; p < npockets; p++)
+        {
+            double opp = opponents[c * npockets + p];
+            if (opp <= 0.0)
+                continue;
+            double equity = shares[c * npockets + p] / opp;
+            size_t bin = min(bins - 1, static_cast<size_t>(equity * bins));
+            counts[p * bins + bin]++;
+        }
+}
+
+vector<CardSet> allPockets()
+{
+    vector<CardSet> pockets(EquityTable::NUM_POCKETS);
+    for (uint8_t c2 = 1; c2 < STANDARD_DECK_SIZE; c2++)
+        for (uint8_t c1 = 0; c1 < c2; c1++)
+        {
+            CardSet pocket = CardSet(Card(c1));
+            pocket.insert(Card(c2));
+            pockets[EquityTable::pocketIndex(pocket)] = pocket;
+        }
+    return pockets;
+}
+}  // namespace
+
+EquityHistogram::EquityHistogram()
+    : _boardSize(0)
+    , _bins(0)
+    , _weights()
+    , _boards()
+    , _counts()
+{}
+
+bool EquityHistogram::open(const string& filename)
+{
+    close();
+
+    ifstream in(filename.c_str(), ios::in | ios::binary);
+    if (!in)
+        return false;
+
+    HistogramHeader header;
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+        header.version != kVersion || header.bins == 0 ||
+        header.numBoards == 0)
+        return false;
+
+    vector<double> weights(EquityTable::NUM_POCKETS);
+    vector<uint64_t> boards(header.numBoards);
+    vector<uint8_t> counts(static_cast<size_t>(header.numBoards) *
+                           EquityTable::NUM_POCKETS * header.bins);
+    in.read(reinterpret_cast<char*>(weights.data()),
+            weights.size() * sizeof(double));
+    in.read(reinterpret_cast<char*>(boards.data()),
+            boards.size() * sizeof(uint64_t));
+    in.read(reinterpret_cast<char*>(counts.data()), counts.size());
+    if (!in || in.peek() != ifstream::traits_type::eof())
+        return false;
+
+    _boardSize = header.boardSize;
+    _bins = header.bins;
+    _weights.swap(weights);
+    _boards.swap(boards);
+    _counts.swap(counts);
+    return true;
+}
+
+void EquityHistogram::close()
+{
+    _boardSize = 0;
+    _bins = 0;
+    _weights.clear();
+    _boards.clear();
+    _counts.clear();
+}
+
+vector<int> EquityHistogram::histogram(const CardSet& pocket,
+                                       const CardSet& board) const
+{
+    if (!isOpen() || pocket.size() != 2 || board.size() != _boardSize ||
+        pocket.intersects(board))
+        return vector<int>();
+
+    uint64_t key = board.canonize().mask();
+    vector<uint64_t>::const_iterator it =
+        lower_bound(_boards.begin(), _boards.end(), key);
+    if (it == _boards.end() || *it != key)
+        return vector<int>();
+
+    size_t index = EquityTable::pocketIndex(canonizeToBoard(board, pocket));
+    const uint8_t* row =
+        &_counts[((it - _boards.begin()) * EquityTable::NUM_POCKETS + index) *
+                 _bins];
+    return vector<int>(row, row + _bins);
+}
+
+vector<double> EquityHistogram::rangeWeights(const CardDistribution& range)
+{
+    vector<double> weights(EquityTable::NUM_POCKETS, 0.0);
+    for (size_t i = 0; i < range.size(); i++)
+        if (range[i].size() == 2)
+            weights[EquityTable::pocketIndex(range[i])] += range[range[i]];
+    return weights;
+}
+
+bool EquityHistogram::isSuitSymmetric(const vector<double>& weights)
+{
+    if (weights.empty())
+        return true;
+    if (weights.size() != EquityTable::NUM_POCKETS)
+        return false;
+
+    vector<CardSet> pockets = allPockets();
+    int suits[] = {0, 1, 2, 3};
+    while (next_permutation(suits, suits + 4))
+        for (size_t p = 0; p < pockets.size(); p++)
+        {
+            CardSet rotated =
+                pockets[p].rotateSuits(suits[0], suits[1], suits[2], suits[3]);
+            if (weights[EquityTable::pocketIndex(rotated)] != weights[p])
+                return false;
+        }
+    return true;
+}
+
+bool EquityHistogram::generate(const string& filename,
+                               const vector<CardSet>& boards,
+                               size_t bins,
+                               const vector<double>& weights,
+                               size_t threads)
+{
+    if (boards.empty() || bins == 0 || !isSuitSymmetric(weights))
+        return false;
+
+    set<uint64_t> keys;
+    for (const CardSet& board : boards)
+    {
+        if (board.size() != boards[0].size() || board.size() < 3 ||
+            board.size() >= kFullBoard)
+            return false;
+        keys.insert(board.canonize().mask());
+    }
+
+    ofstream out(filename.c_str(), ios::out | ios::binary);
+    if (!out)
+        return false;
+
+    HistogramHeader header;
+    memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.boardSize = static_cast<uint32_t>(boards[0].size());
+    header.numBoards = static_cast<uint32_t>(keys.size());
+    header.bins = static_cast<uint32_t>(bins);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    vector<double> written(weights);
+    if (written.empty())
+        written.assign(EquityTable::NUM_POCKETS, 1.0);
+    out.write(reinterpret_cast<const char*>(written.data()),
+              written.size() * sizeof(double));
+    vector<uint64_t> sorted(keys.begin(), keys.end());
+    out.write(reinterpret_cast<const char*>(sorted.data()),
+              sorted.size() * sizeof(uint64_t));
+
+    // boards are computed a block at a time and written in order
+    threads = max<size_t>(threads, 1);
+    const size_t rowSize = EquityTable::NUM_POCKETS * bins;
+    const size_t block = threads * kBlock;
+    vector<uint8_t> counts;
+    for (size_t first = 0; first < sorted.size() && out; first += block)
+    {
+        size_t n = min(block, sorted.size() - first);
+        counts.resize(n * rowSize);
+        atomic<size_t> next(0);
+        auto worker = [&]() {
+            for (size_t i = next++; i < n; i = next++)
+                boardHistograms(CardSet(sorted[first + i]), bins, weights,
+                                &counts[i * rowSize]);
+        };
+
+        vector<std::thread> pool;
+        for (size_t t = 1; t < min(threads, n); t++)
+            pool.push_back(std::thread(worker));
+        worker();
+        for (std::thread& t : pool)
+            t.join();
+
+        out.write(reinterpret_cast<const char*>(counts.data()), counts.size());
+    }
+    return out.good();
+}
+
+}  // namespace pokerstove
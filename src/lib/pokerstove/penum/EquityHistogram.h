@@ -0,0 +1,89 @@
+/**
+ * Copyright (c) 2012 Andrew Prock. All rights reserved.
+ */
+#ifndef PENUM_EQUITYHISTOGRAM_H_
+#define PENUM_EQUITYHISTOGRAM_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "CardDistribution.h"
+#include <pokerstove/peval/CardSet.h>
+
+namespace pokerstove
+{
+/**
+ * Precomputed hand strength distributions for hold'em.  For every pocket
+ * on every canonical flop or turn, the histogram of its equity against an
+ * opponent range on each board of the next street: one count per turn or
+ * river card, in the bin of the pocket's equity on that board.  Equity on
+ * a turn is exact over every river.
+ *
+ * The river showdowns are shared.  Each runout to the river is sorted
+ * once for every pocket (EquityTable::riverShares), and its shares are
+ * added to each next street board it completes, so a flop sorts 1176
+ * rivers rather than 49 turns of 46.
+ *
+ * File layout, all values in host byte order:
+ *
+ *   header     "PSEH", version, board size, number of boards, bins
+ *   weights    double[NUM_POCKETS] opponent range, by pocketIndex()
+ *   boards     uint64 canonical board masks, sorted
+ *   counts     uint8[NUM_POCKETS][bins] per board, pockets by pocketIndex()
+ *
+ * Pockets which collide with the board have no counts.  The file is read
+ * into memory, a flop table with 50 bins is about 116MB.
+ */
+class EquityHistogram
+{
+public:
+    EquityHistogram();
+
+    bool open(const std::string& filename);
+    void close();
+
+    bool isOpen() const { return !_boards.empty(); }
+    size_t boardSize() const { return _boardSize; }
+    size_t numBoards() const { return _boards.size(); }
+    size_t bins() const { return _bins; }
+    const std::vector<double>& weights() const { return _weights; }
+
+    /**
+     * the histogram of the pocket on the board, empty if the board is not
+     * in the table or the cards collide
+     */
+    std::vector<int> histogram(const CardSet& pocket,
+                               const CardSet& board) const;
+
+    /**
+     * Weights of the opponent hands, indexed by pocketIndex(), from a
+     * distribution of two card hands.  Canonical boards only stand for
+     * their suit permutations if the weights do not depend on suits.
+     */
+    static std::vector<double> rangeWeights(const CardDistribution& range);
+    static bool isSuitSymmetric(const std::vector<double>& weights);
+
+    /**
+     * Write histograms for the given flops or turns, which are canonized
+     * and sorted before use, against the given opponent weights, or a
+     * random hand if they are empty.  Boards are spread over the given
+     * number of threads.  Fails if the boards are not all flops or all
+     * turns, or the weights are not suit symmetric.
+     */
+    static bool generate(const std::string& filename,
+                         const std::vector<CardSet>& boards,
+                         size_t bins,
+                         const std::vector<double>& weights = std::vector<double>(),
+                         size_t threads = 1);
+
+private:
+    size_t _boardSize;
+    size_t _bins;
+    std::vector<double> _weights;
+    std::vector<uint64_t> _boards;
+    std::vector<uint8_t> _counts;
+};
+
+}  // namespace pokerstove
+
+#endif  // PENUM_EQUITYHISTOGRAM_H_
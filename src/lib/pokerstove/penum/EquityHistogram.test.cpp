@@ -0,0 +1,134 @@
+#include "EquityHistogram.h"
+#include "RangeDistribution.h"
+#include "ShowdownEnumerator.h"
+#include <pokerstove/peval/Card.h>
+#include <gtest/gtest.h>
+
+using namespace pokerstove;
+using namespace std;
+
+namespace
+{
+double showdownEquity(const CardSet& pocket,
+                      const CardDistribution& range,
+                      const CardSet& board)
+{
+    vector<CardDistribution> dists;
+    dists.push_back(CardDistribution(pocket));
+    dists.push_back(range);
+
+    ShowdownEnumerator showdown;
+    vector<EquityResult> results =
+        showdown.calculateEquity(dists, board, PokerHandEvaluator::alloc("h"));
+    return results[0].shares() / (results[0].shares() + results[1].shares());
+}
+
+vector<int> showdownHistogram(const CardSet& pocket,
+                              const CardDistribution& range,
+                              const CardSet& board,
+                              size_t bins)
+{
+    vector<int> counts(bins, 0);
+    CardSet deck;
+    deck.fill();
+    for (const Card& c : (deck ^ (pocket | board)).cards())
+    {
+        double equity = showdownEquity(pocket, range, board | CardSet(c));
+        counts[min(bins - 1, static_cast<size_t>(equity * bins))]++;
+    }
+    return counts;
+}
+}  // namespace
+
+TEST(EquityHistogram, TurnAgainstRandomHand)
+{
+    vector<CardSet> boards;
+    boards.push_back(CardSet("2h7h9hJc"));
+    string filename = testing::TempDir() + "turn.eqh";
+    ASSERT_TRUE(EquityHistogram::generate(filename, boards, 10));
+
+    EquityHistogram table;
+    ASSERT_TRUE(table.open(filename));
+    EXPECT_EQ(4, table.boardSize());
+    EXPECT_EQ(1, table.numBoards());
+    EXPECT_EQ(10, table.bins());
+
+    CardSet deck;
+    deck.fill();
+    CardDistribution random;
+    const char* pockets[] = {"AhKs", "8c8d", "Td8s"};
+    for (const char* p : pockets)
+    {
+        CardSet pocket(p);
+        random.fill(deck ^ (pocket | boards[0]), 2);
+        EXPECT_EQ(showdownHistogram(pocket, random, boards[0], 10),
+                  table.histogram(pocket, boards[0]))
+            << pocket.str();
+    }
+
+    // lookups through a suit permutation, and misses
+    EXPECT_EQ(table.histogram(CardSet("AhKs"), CardSet("2h7h9hJc")),
+              table.histogram(CardSet("AdKc"), CardSet("2d7d9dJs")));
+    EXPECT_TRUE(table.histogram(CardSet("AhKs"), CardSet("2h7h9hQc")).empty());
+    EXPECT_TRUE(table.histogram(CardSet("AhJc"), CardSet("2h7h9hJc")).empty());
+}
+
+TEST(EquityHistogram, FlopAgainstRange)
+{
+    RangeDistribution range;
+    ASSERT_TRUE(range.parse("QQ+,AKs,T9s"));
+    vector<double> weights = EquityHistogram::rangeWeights(range);
+
+    vector<CardSet> boards;
+    boards.push_back(CardSet("Ks8d3c"));
+    string filename = testing::TempDir() + "flop.eqh";
+    ASSERT_TRUE(EquityHistogram::generate(filename, boards, 8, weights, 2));
+
+    EquityHistogram table;
+    ASSERT_TRUE(table.open(filename));
+    EXPECT_EQ(weights, table.weights());
+
+    CardSet pocket("Ac8c");
+    vector<int> counts = table.histogram(pocket, boards[0]);
+    CardDistribution live = range.data();
+    live.removeCards(pocket | boards[0]);
+    EXPECT_EQ(showdownHistogram(pocket, live, boards[0], 8), counts);
+}
+
+TEST(EquityHistogram, ThreadsDoNotChangeResults)
+{
+    vector<CardSet> boards;
+    boards.push_back(CardSet("2c5d9hKs"));
+    boards.push_back(CardSet("3c4c5c6c"));
+    boards.push_back(CardSet("AhAdQs2s"));
+    string one = testing::TempDir() + "one.eqh";
+    string four = testing::TempDir() + "four.eqh";
+    ASSERT_TRUE(EquityHistogram::generate(one, boards, 20));
+    ASSERT_TRUE(EquityHistogram::generate(four, boards, 20, vector<double>(), 4));
+
+    EquityHistogram a, b;
+    ASSERT_TRUE(a.open(one));
+    ASSERT_TRUE(b.open(four));
+    for (const CardSet& board : boards)
+        EXPECT_EQ(a.histogram(CardSet("7d7s"), board),
+                  b.histogram(CardSet("7d7s"), board));
+}
+
+TEST(EquityHistogram, InvalidInput)
+{
+    string filename = testing::TempDir() + "invalid.eqh";
+    vector<CardSet> rivers(1, CardSet("2c5d9hKsAs"));
+    EXPECT_FALSE(EquityHistogram::generate(filename, rivers, 10));
+
+    // a range which depends on suits is not the same on every
+    // permutation of a canonical board
+    RangeDistribution suited;
+    ASSERT_TRUE(suited.parse("AhKh"));
+    vector<double> weights = EquityHistogram::rangeWeights(suited);
+    EXPECT_FALSE(EquityHistogram::isSuitSymmetric(weights));
+    vector<CardSet> turns(1, CardSet("2c5d9hKs"));
+    EXPECT_FALSE(EquityHistogram::generate(filename, turns, 10, weights));
+
+    EquityHistogram table;
+    EXPECT_FALSE(table.open(testing::TempDir() + "missing.eqh"));
+}
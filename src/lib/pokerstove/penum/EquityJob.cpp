@@ -0,0 +1,183 @@
+/**
+ * Copyright (c) 2012 Andrew Prock. All rights reserved.
+ */
+#include "EquityJob.h"
+
+#include <stdexcept>
+#include "ShowdownEnumerator.h"
+
+using namespace std;
+
+namespace pokerstove
+{
+
+EquityJob::EquityJob(const vector<CardDistribution>& dists,
+                     const CardSet& board,
+                     std::shared_ptr<PokerHandEvaluator> peval)
+    : _dists(dists)
+    , _board(board)
+    , _peval(peval)
+    , _work(false)
+    , _combos(false)
+    , _begin(0)
+    , _end(0)
+    , _checkpoint(NULL)
+    , _monitor()
+    , _thread()
+    , _started(false)
+    , _done(false)
+    , _start()
+    , _elapsed(0.0)
+    , _mutex()
+    , _results()
+    , _comboResults()
+    , _stats()
+    , _part()
+    , _error()
+{}
+
+EquityJob::~EquityJob()
+{
+    cancel();
+    if (_thread.joinable())
+        _thread.join();
+}
+
+void EquityJob::setWork(const PartialEquity& part,
+                        uint64_t begin,
+                        uint64_t end,
+                        EnumerationCheckpoint* checkpoint)
+{
+    if (_started)
+        throw runtime_error("EquityJob, job already started");
+    if (_combos)
+        throw runtime_error("EquityJob, work units are not broken down by hand");
+    _work = true;
+    _part = part;
+    _begin = begin;
+    _end = end;
+    _checkpoint = checkpoint;
+}
+
+void EquityJob::setCombos()
+{
+    if (_started)
+        throw runtime_error("EquityJob, job already started");
+    if (_work)
+        throw runtime_error("EquityJob, work units are not broken down by hand");
+    _combos = true;
+}
+
+vector<ComboResult> EquityJob::combos() const
+{
+    lock_guard<mutex> lock(_mutex);
+    return _comboResults;
+}
+
+PartialEquity EquityJob::partial() const
+{
+    lock_guard<mutex> lock(_mutex);
+    return _part;
+}
+
+void EquityJob::start()
+{
+    if (_started.exchange(true))
+        throw runtime_error("EquityJob, job already started");
+    _start = chrono::steady_clock::now();
+    _thread = thread(&EquityJob::run, this);
+}
+
+void EquityJob::wait()
+{
+    if (_thread.joinable())
+        _thread.join();
+}
+
+string EquityJob::error() const
+{
+    lock_guard<mutex> lock(_mutex);
+    return _error;
+}
+
+double EquityJob::elapsed() const
+{
+    if (!_started)
+        return 0.0;
+    if (_done)
+        return _elapsed;
+    chrono::duration<double> d = chrono::steady_clock::now() - _start;
+    return d.count();
+}
+
+double EquityJob::evaluationsPerSecond() const
+{
+    double seconds = elapsed();
+    return (seconds > 0.0) ? evaluations() / seconds : 0.0;
+}
+
+vector<EquityResult> EquityJob::results() const
+{
+    {
+        lock_guard<mutex> lock(_mutex);
+        if (_done)
+            return _results;
+    }
+    return _monitor.results();
+}
+
+EnumerationStats EquityJob::stats() const
+{
+    lock_guard<mutex> lock(_mutex);
+    return _stats;
+}
+
+void EquityJob::run()
+{
+    vector<EquityResult> results;
+    vector<ComboResult> combos;
+    EnumerationStats stats;
+    PartialEquity part = _part;
+    string error;
+    try
+    {
+        ShowdownEnumerator showdown;
+        if (_work)
+        {
+            showdown.resumePartialEquity(part, _dists, _board, _peval, _begin,
+                                         _end, &_monitor, _checkpoint, &stats);
+            results = part.results();
+            if (part.exact())
+                for (size_t i = 0; i < part.size(); i++)
+                    results[i] = part.exactResults()[i].result();
+        }
+        else if (_combos)
+        {
+            results = showdown.calculateComboEquity(_dists, _board, _peval, combos,
+                                                    &_monitor, &stats);
+        }
+        else
+        {
+            results = showdown.calculateEquity(_dists, _board, _peval, &_monitor, &stats);
+        }
+    }
+    catch (std::exception& e)
+    {
+        error = e.what();
+        results = _monitor.results();
+    }
+
+    chrono::duration<double> d = chrono::steady_clock::now() - _start;
+    {
+        lock_guard<mutex> lock(_mutex);
+        _results = results;
+        _comboResults = combos;
+        _stats = stats;
+        _part = part;
+        _error = error;
+    }
+    _elapsed = d.count();
+    _done = true;
+}
+
+}  // namespace pokerstove
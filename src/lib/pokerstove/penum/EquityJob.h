@@ -0,0 +1,170 @@
+/**
+ * Copyright (c) 2012 Andrew Prock. All rights reserved.
+ */
+#ifndef PENUM_EQUITYJOB_H_
+#define PENUM_EQUITYJOB_H_
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <pokerstove/peval/PokerHandEvaluator.h>
+#include "CardDistribution.h"
+#include "EnumerationMonitor.h"
+#include "EnumerationStats.h"
+#include "PartialEquity.h"
+#include "ShowdownEnumerator.h"
+
+namespace pokerstove
+{
+class EnumerationCheckpoint;
+
+/**
+ * A ShowdownEnumerator::calculateEquity run on a background thread.
+ * The job can be polled for progress, cancelled, and asked for the
+ * results accumulated so far, which together with fraction() give a
+ * partial answer for jobs which are stopped early.
+ *
+ * usage:
+ *
+ *   EquityJob job(dists, board, evaluator);
+ *   job.start();
+ *   while (!job.done())
+ *   {
+ *       report(job.fraction(), job.evaluationsPerSecond());
+ *       if (tooSlow)
+ *           job.cancel();
+ *       sleep();
+ *   }
+ *   vector<EquityResult> results = job.results();
+ */
+class EquityJob
+{
+public:
+    EquityJob(const std::vector<CardDistribution>& dists,
+              const CardSet& board,
+              std::shared_ptr<PokerHandEvaluator> peval);
+
+    /**
+     * a running job is cancelled, and waited for
+     */
+    ~EquityJob();
+
+    /**
+     * Run the job as a work unit instead, continuing part over the
+     * showdowns [begin,end) with ShowdownEnumerator::resumePartialEquity
+     * and saving progress to the checkpoint if one is given.  The
+     * checkpoint must outlive the job.  Call before start().
+     */
+    void setWork(const PartialEquity& part,
+                 uint64_t begin,
+                 uint64_t end,
+                 EnumerationCheckpoint* checkpoint = NULL);
+
+    /**
+     * Also break the results down by hand, see
+     * ShowdownEnumerator::calculateComboEquity.  Work unit jobs do not
+     * support this.  Call before start().
+     */
+    void setCombos();
+
+    /**
+     * the results of each hand once the job is done, empty unless
+     * setCombos was called
+     */
+    std::vector<ComboResult> combos() const;
+
+    /**
+     * the partial result of a work unit job once it is done
+     */
+    PartialEquity partial() const;
+
+    /**
+     * start the enumeration, a job can only be started once
+     */
+    void start();
+
+    /**
+     * ask the enumeration to stop, it does so within a fraction of a
+     * second, use wait() or done() to find out when
+     */
+    void cancel() { _monitor.cancel(); }
+
+    /**
+     * block until the enumeration has finished or stopped
+     */
+    void wait();
+
+    bool started() const { return _started; }
+    bool done() const { return _done; }
+    bool cancelled() const { return _monitor.cancelled(); }
+
+    /**
+     * the error message if the enumeration threw, empty otherwise
+     */
+    std::string error() const;
+
+    /**
+     * fraction of the enumeration space covered, 1.0 when complete
+     */
+    double fraction() const { return _monitor.fraction(); }
+
+    uint64_t evaluations() const { return _monitor.evaluations(); }
+
+    /**
+     * seconds since the job was started, frozen when it is done
+     */
+    double elapsed() const;
+
+    double evaluationsPerSecond() const;
+
+    /**
+     * the final results once the job is done, or the latest snapshot of
+     * the results while it is running
+     */
+    std::vector<EquityResult> results() const;
+
+    /**
+     * enumeration counters, available once the job is done and only
+     * gathered in POKERSTOVE_STATS builds
+     */
+    EnumerationStats stats() const;
+
+private:
+    // non-copyable
+    EquityJob(const EquityJob&);
+    EquityJob& operator=(const EquityJob&);
+
+    void run();
+
+    std::vector<CardDistribution> _dists;
+    CardSet _board;
+    std::shared_ptr<PokerHandEvaluator> _peval;
+
+    bool _work;
+    bool _combos;
+    uint64_t _begin;
+    uint64_t _end;
+    EnumerationCheckpoint* _checkpoint;
+
+    EnumerationMonitor _monitor;
+    std::thread _thread;
+    std::atomic<bool> _started;
+    std::atomic<bool> _done;
+    std::chrono::steady_clock::time_point _start;
+    std::atomic<double> _elapsed;
+
+    mutable std::mutex _mutex;
+    std::vector<EquityResult> _results;
+    std::vector<ComboResult> _comboResults;
+    EnumerationStats _stats;
+    PartialEquity _part;
+    std::string _error;
+};
+
+}  // namespace pokerstove
+
+#endif  // PENUM_EQUITYJOB_H_
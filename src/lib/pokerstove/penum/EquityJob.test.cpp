@@ -0,0 +1,83 @@
+#include "EquityJob.h"
+#include "ShowdownEnumerator.h"
+#include <gtest/gtest.h>
+
+using namespace pokerstove;
+using namespace std;
+
+TEST(EquityJob, RunsToCompletion)
+{
+    std::shared_ptr<PokerHandEvaluator> peval = PokerHandEvaluator::alloc("h");
+    vector<CardDistribution> dists;
+    dists.push_back(CardDistribution(CardSet("AcAd")));
+    dists.push_back(CardDistribution(CardSet("KhQh")));
+    CardSet board("2c7h9s");
+
+    EquityJob job(dists, board, peval);
+    EXPECT_FALSE(job.started());
+    job.start();
+    job.wait();
+    EXPECT_TRUE(job.done());
+    EXPECT_FALSE(job.cancelled());
+    EXPECT_EQ(1.0, job.fraction());
+    EXPECT_EQ(990, job.evaluations());
+    EXPECT_TRUE(job.error().empty());
+    EXPECT_THROW(job.start(), std::runtime_error);
+
+    ShowdownEnumerator showdown;
+    vector<EquityResult> expected = showdown.calculateEquity(dists, board, peval);
+    vector<EquityResult> results = job.results();
+    ASSERT_EQ(2, results.size());
+    EXPECT_EQ(expected[0].winShares, results[0].winShares);
+    EXPECT_EQ(expected[1].tieShares, results[1].tieShares);
+}
+
+TEST(EquityJob, Combos)
+{
+    std::shared_ptr<PokerHandEvaluator> peval = PokerHandEvaluator::alloc("h");
+    vector<CardDistribution> dists(2);
+    ASSERT_TRUE(dists[0].parse("AcAd,KcKd"));
+    dists[1].parse("QhJh");
+    CardSet board("2c7h9s");
+
+    EquityJob job(dists, board, peval);
+    job.setCombos();
+    job.start();
+    job.wait();
+    EXPECT_THROW(job.setCombos(), std::runtime_error);
+
+    ShowdownEnumerator showdown;
+    vector<ComboResult> expected;
+    showdown.calculateComboEquity(dists, board, peval, expected);
+    vector<ComboResult> combos = job.combos();
+    ASSERT_EQ(3, combos.size());
+    for (size_t i = 0; i < combos.size(); i++)
+        EXPECT_EQ(expected[i].winShares, combos[i].winShares);
+}
+
+TEST(EquityJob, Cancel)
+{
+    // three way omaha preflop is far too big to finish during the test
+    std::shared_ptr<PokerHandEvaluator> peval = PokerHandEvaluator::alloc("O");
+    vector<CardDistribution> dists;
+    dists.push_back(CardDistribution(CardSet("AcAdKcKd")));
+    dists.push_back(CardDistribution());
+    dists.push_back(CardDistribution());
+
+    EquityJob job(dists, CardSet(), peval);
+    job.start();
+    while (job.evaluations() == 0)
+        this_thread::sleep_for(chrono::milliseconds(1));
+    job.cancel();
+    job.wait();
+
+    EXPECT_TRUE(job.done());
+    EXPECT_TRUE(job.cancelled());
+    EXPECT_GT(job.fraction(), 0.0);
+    EXPECT_LT(job.fraction(), 1.0);
+    EXPECT_GT(job.evaluationsPerSecond(), 0.0);
+
+    vector<EquityResult> results = job.results();
+    ASSERT_EQ(3, results.size());
+    EXPECT_GT(results[0].winShares + results[0].tieShares, 0.0);
+}
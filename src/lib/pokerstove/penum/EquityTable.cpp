@@ -0,0 +1,327 @@
+/**
+ * Copyright (c) 2012 Andrew Prock. All rights reserved.
+ */
+#include "EquityTable.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <set>
+#include <pokerstove/peval/Card.h>
+#include <pokerstove/peval/PokerEvaluation.h>
+#include <pokerstove/util/combinations.h>
+#include <pokerstove/util/lastbit.h>
+
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace pokerstove
+{
+
+namespace
+{
+const char kMagic[4] = {'P', 'S', 'E', 'Q'};
+const uint32_t kVersion = 1;
+const size_t kFullBoard = 5;
+
+struct TableHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t boardSize;
+    uint32_t numBoards;
+};
+
+struct Showdown
+{
+    int code;
+    uint8_t c1;
+    uint8_t c2;
+    uint16_t index;
+
+    bool operator<(const Showdown& other) const { return code < other.code; }
+};
+
+/**
+ * Exact equity of every pocket against a random hand on one board, the
+ * river shares summed over every runout.
+ */
+void boardEquities(const CardSet& board, vector<double>& equities)
+{
+    vector<double> shares(EquityTable::NUM_POCKETS, 0.0);
+    vector<double> opponents(EquityTable::NUM_POCKETS, 0.0);
+    vector<double> riverShares;
+    vector<double> riverOpponents;
+
+    vector<uint8_t> live;
+    for (uint8_t c = 0; c < STANDARD_DECK_SIZE; c++)
+        if (!board.contains(Card(c)))
+            live.push_back(c);
+
+    combinations runout(live.size(), kFullBoard - board.size());
+    do
+    {
+        CardSet full = board;
+        for (size_t i = 0; i < runout.size(); i++)
+            full.insert(Card(live[runout[i]]));
+        EquityTable::riverShares(full, vector<double>(), riverShares,
+                                 riverOpponents);
+        for (size_t i = 0; i < EquityTable::NUM_POCKETS; i++)
+        {
+            shares[i] += riverShares[i];
+            opponents[i] += riverOpponents[i];
+        }
+    } while (runout.next());
+
+    equities.assign(EquityTable::NUM_POCKETS, 0.0);
+    for (size_t i = 0; i < EquityTable::NUM_POCKETS; i++)
+        if (opponents[i] > 0.0)
+            equities[i] = shares[i] / opponents[i];
+}
+}  // namespace
+
+EquityTable::EquityTable()
+    : _data(NULL)
+    , _length(0)
+    , _buffer()
+    , _boardSize(0)
+    , _numBoards(0)
+    , _boards(NULL)
+    , _equities(NULL)
+{}
+
+EquityTable::~EquityTable()
+{
+    close();
+}
+
+bool EquityTable::open(const string& filename)
+{
+    close();
+
+#ifdef WIN32
+    ifstream in(filename.c_str(), ios::in | ios::binary);
+    if (!in)
+        return false;
+    _buffer.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+    _data = _buffer.data();
+    _length = _buffer.size();
+#else
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0)
+    {
+        ::close(fd);
+        return false;
+    }
+    void* data = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED)
+        return false;
+    _data = static_cast<const char*>(data);
+    _length = st.st_size;
+#endif
+
+    // validate the header and the size of the file
+    TableHeader header;
+    if (_length < sizeof(header))
+    {
+        close();
+        return false;
+    }
+    memcpy(&header, _data, sizeof(header));
+    size_t expected = sizeof(header) + header.numBoards * sizeof(uint64_t) +
+                      header.numBoards * NUM_POCKETS * sizeof(uint16_t);
+    if (memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+        header.version != kVersion || _length != expected)
+    {
+        close();
+        return false;
+    }
+
+    _boardSize = header.boardSize;
+    _numBoards = header.numBoards;
+    _boards = reinterpret_cast<const uint64_t*>(_data + sizeof(header));
+    _equities = reinterpret_cast<const uint16_t*>(_boards + _numBoards);
+    return true;
+}
+
+void EquityTable::close()
+{
+#ifndef WIN32
+    if (_data != NULL)
+        munmap(const_cast<char*>(_data), _length);
+#endif
+    _buffer.clear();
+    _data = NULL;
+    _length = 0;
+    _boardSize = 0;
+    _numBoards = 0;
+    _boards = NULL;
+    _equities = NULL;
+}
+
+double EquityTable::equity(const CardSet& pocket, const CardSet& board) const
+{
+    if (!isOpen() || pocket.size() != 2 || board.size() != _boardSize ||
+        pocket.intersects(board))
+        return -1.0;
+
+    uint64_t key = board.canonize().mask();
+    const uint64_t* end = _boards + _numBoards;
+    const uint64_t* it = lower_bound(_boards, end, key);
+    if (it == end || *it != key)
+        return -1.0;
+
+    size_t index = pocketIndex(canonizeToBoard(board, pocket));
+    return _equities[(it - _boards) * NUM_POCKETS + index] / 65535.0;
+}
+
+void EquityTable::riverShares(const CardSet& board,
+                              const vector<double>& weights,
+                              vector<double>& shares,
+                              vector<double>& opponents)
+{
+    shares.assign(NUM_POCKETS, 0.0);
+    opponents.assign(NUM_POCKETS, 0.0);
+
+    // every live pocket is evaluated once and sorted, then the wins and
+    // ties against the opponent are counted by subtracting the opponent
+    // hands which share a card with the pocket
+    vector<Showdown> showdowns;
+    showdowns.reserve(NUM_POCKETS);
+    double total = 0.0;
+    double cardWeight[STANDARD_DECK_SIZE] = {0.0};
+    for (uint8_t c2 = 1; c2 < STANDARD_DECK_SIZE; c2++)
+    {
+        if (board.contains(Card(c2)))
+            continue;
+        for (uint8_t c1 = 0; c1 < c2; c1++)
+        {
+            if (board.contains(Card(c1)))
+                continue;
+            CardSet pocket = CardSet(Card(c1));
+            pocket.insert(Card(c2));
+            Showdown s;
+            s.code = CardSet(board | pocket).evaluateHigh().code();
+            s.c1 = c1;
+            s.c2 = c2;
+            s.index = static_cast<uint16_t>(pocketIndex(pocket));
+            showdowns.push_back(s);
+
+            double w = weights.empty() ? 1.0 : weights[s.index];
+            total += w;
+            cardWeight[c1] += w;
+            cardWeight[c2] += w;
+        }
+    }
+    sort(showdowns.begin(), showdowns.end());
+
+    double below = 0.0;
+    double belowCard[STANDARD_DECK_SIZE] = {0.0};
+    double groupCard[STANDARD_DECK_SIZE] = {0.0};
+    size_t i = 0;
+    while (i < showdowns.size())
+    {
+        size_t j = i;
+        double group = 0.0;
+        while (j < showdowns.size() && showdowns[j].code == showdowns[i].code)
+        {
+            const Showdown& s = showdowns[j];
+            double w = weights.empty() ? 1.0 : weights[s.index];
+            group += w;
+            groupCard[s.c1] += w;
+            groupCard[s.c2] += w;
+            j++;
+        }
+        for (size_t k = i; k < j; k++)
+        {
+            // a pocket is counted in the weight of both its cards
+            const Showdown& s = showdowns[k];
+            double w = weights.empty() ? 1.0 : weights[s.index];
+            double wins = below - belowCard[s.c1] - belowCard[s.c2];
+            double ties = group - groupCard[s.c1] - groupCard[s.c2] + w;
+            shares[s.index] = wins + 0.5 * ties;
+            opponents[s.index] = total - cardWeight[s.c1] - cardWeight[s.c2] + w;
+        }
+        for (size_t k = i; k < j; k++)
+        {
+            const Showdown& s = showdowns[k];
+            belowCard[s.c1] += groupCard[s.c1];
+            belowCard[s.c2] += groupCard[s.c2];
+            groupCard[s.c1] = 0.0;
+            groupCard[s.c2] = 0.0;
+        }
+        below += group;
+        i = j;
+    }
+}
+
+size_t EquityTable::pocketIndex(const CardSet& pocket)
+{
+    uint64_t mask = pocket.mask();
+    size_t c1 = lastbit(mask);
+    size_t c2 = lastbit(mask ^ (UINT64_C(1) << c1));
+    return c2 * (c2 - 1) / 2 + c1;
+}
+
+vector<CardSet> EquityTable::canonicalBoards(size_t boardSize)
+{
+    set<CardSet> boards;
+    combinations cards(STANDARD_DECK_SIZE, boardSize);
+    do
+    {
+        boards.insert(CardSet(cards.getMask()).canonize());
+    } while (cards.next());
+    return vector<CardSet>(boards.begin(), boards.end());
+}
+
+bool EquityTable::generate(const string& filename, const vector<CardSet>& boards)
+{
+    if (boards.empty())
+        return false;
+
+    set<uint64_t> keys;
+    for (const CardSet& board : boards)
+    {
+        if (board.size() != boards[0].size() || board.size() > kFullBoard)
+            return false;
+        keys.insert(board.canonize().mask());
+    }
+
+    ofstream out(filename.c_str(), ios::out | ios::binary);
+    if (!out)
+        return false;
+
+    TableHeader header;
+    memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.boardSize = static_cast<uint32_t>(boards[0].size());
+    header.numBoards = static_cast<uint32_t>(keys.size());
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (uint64_t key : keys)
+        out.write(reinterpret_cast<const char*>(&key), sizeof(key));
+
+    vector<double> equities;
+    vector<uint16_t> row(NUM_POCKETS);
+    for (uint64_t key : keys)
+    {
+        boardEquities(CardSet(key), equities);
+        for (size_t i = 0; i < NUM_POCKETS; i++)
+            row[i] = static_cast<uint16_t>(lround(equities[i] * 65535.0));
+        out.write(reinterpret_cast<const char*>(row.data()),
+                  row.size() * sizeof(uint16_t));
+    }
+    return out.good();
+}
+
+}  // namespace pokerstove
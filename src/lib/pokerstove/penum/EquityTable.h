@@ -0,0 +1,101 @@
+/**
+ * Copyright (c) 2012 Andrew Prock. All rights reserved.
+ */
+#ifndef PENUM_EQUITYTABLE_H_
+#define PENUM_EQUITYTABLE_H_
+
+#include <string>
+#include <vector>
+#include <pokerstove/peval/CardSet.h>
+
+namespace pokerstove
+{
+/**
+ * A precomputed table of hold'em equity against a single random hand, for
+ * every pocket pair on every canonical flop, turn, or river.  One table
+ * covers one street.
+ *
+ * Boards are stored in canonical form (CardSet::canonize), and pockets
+ * are rotated with the same suit permutation (canonizeToBoard), so a
+ * lookup is a canonization, a binary search over the boards, and a
+ * single read.
+ *
+ * File layout, all values in host byte order:
+ *
+ *   header     "PSEQ", version, board size, number of boards
+ *   boards     uint64 canonical board masks, sorted
+ *   equities   uint16[NUM_POCKETS] per board, equity * 65535, indexed by
+ *              pocketIndex()
+ *
+ * The file is mapped into memory where mmap is available, and read in
+ * full otherwise.  A river table is about 357MB.
+ */
+class EquityTable
+{
+public:
+    static const size_t NUM_POCKETS = 1326;
+
+    EquityTable();
+    ~EquityTable();
+
+    bool open(const std::string& filename);
+    void close();
+
+    bool isOpen() const { return _boards != NULL; }
+    size_t boardSize() const { return _boardSize; }
+    size_t numBoards() const { return _numBoards; }
+
+    /**
+     * equity of the pocket against a random hand, or a negative value
+     * if the board is not in the table or the cards collide
+     */
+    double equity(const CardSet& pocket, const CardSet& board) const;
+
+    /**
+     * Win shares, with ties as half, of every pocket against an opponent
+     * drawn from weights, on one complete board, and the total weight of
+     * the opponent hands which do not collide with the pocket.  Both are
+     * indexed by pocketIndex().  Empty weights are a random hand, the
+     * entries for pockets which collide with the board are zero.
+     */
+    static void riverShares(const CardSet& board,
+                            const std::vector<double>& weights,
+                            std::vector<double>& shares,
+                            std::vector<double>& opponents);
+
+    /**
+     * colex index of a two card hand, [0,NUM_POCKETS)
+     */
+    static size_t pocketIndex(const CardSet& pocket);
+
+    /**
+     * all the canonical hold'em boards with the given number of cards
+     */
+    static std::vector<CardSet> canonicalBoards(size_t boardSize);
+
+    /**
+     * Write a table for the given boards, which are canonized and sorted
+     * before use.  Equities are exact, every runout and every opponent
+     * hand is considered.
+     */
+    static bool generate(const std::string& filename,
+                         const std::vector<CardSet>& boards);
+
+private:
+    // non-copyable
+    EquityTable(const EquityTable&);
+    EquityTable& operator=(const EquityTable&);
+
+    const char* _data;
+    size_t _length;
+    std::vector<char> _buffer;  // used when the file is not mapped
+
+    size_t _boardSize;
+    size_t _numBoards;
+    const uint64_t* _boards;
+    const uint16_t* _equities;
+};
+
+}  // namespace pokerstove
+
+#endif  // PENUM_EQUITYTABLE_H_
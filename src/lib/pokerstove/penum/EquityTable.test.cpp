@@ -0,0 +1,84 @@
+#include "EquityTable.h"
+#include "ShowdownEnumerator.h"
+#include <gtest/gtest.h>
+
+using namespace pokerstove;
+using namespace std;
+
+namespace
+{
+double showdownEquity(const CardSet& pocket, const CardSet& board)
+{
+    vector<CardDistribution> dists;
+    dists.push_back(CardDistribution(pocket));
+    dists.emplace_back();
+    CardSet deck;
+    deck.fill();
+    dists.back().fill(deck ^ (pocket | board), 2);
+
+    ShowdownEnumerator showdown;
+    vector<EquityResult> results =
+        showdown.calculateEquity(dists, board, PokerHandEvaluator::alloc("h"));
+    return results[0].shares() / (results[0].shares() + results[1].shares());
+}
+}  // namespace
+
+TEST(EquityTable, PocketIndex)
+{
+    EXPECT_EQ(0, EquityTable::pocketIndex(CardSet("2c3c")));
+    EXPECT_EQ(EquityTable::NUM_POCKETS - 1,
+              EquityTable::pocketIndex(CardSet("KsAs")));
+}
+
+TEST(EquityTable, CanonicalBoards)
+{
+    EXPECT_EQ(1755, EquityTable::canonicalBoards(3).size());
+}
+
+TEST(EquityTable, RiverLookup)
+{
+    // a monotone board has suit ties in its canonical form, and a rainbow
+    // board has none
+    vector<CardSet> boards;
+    boards.push_back(CardSet("2h7h9hJhKh"));
+    boards.push_back(CardSet("As8d5c3hTc"));
+    string filename = testing::TempDir() + "river.eqt";
+    ASSERT_TRUE(EquityTable::generate(filename, boards));
+
+    EquityTable table;
+    ASSERT_TRUE(table.open(filename));
+    EXPECT_EQ(5, table.boardSize());
+    EXPECT_EQ(2, table.numBoards());
+
+    const char* pockets[] = {"AhQs", "AcAd", "2c3d", "QdJd", "7s7c"};
+    for (const CardSet& board : boards)
+        for (const char* p : pockets)
+        {
+            CardSet pocket(p);
+            EXPECT_NEAR(showdownEquity(pocket, board),
+                        table.equity(pocket, board), 1e-4)
+                << pocket.str() << " " << board.str();
+        }
+
+    // suit isomorphic boards share an entry
+    EXPECT_EQ(table.equity(CardSet("AhQs"), CardSet("2h7h9hJhKh")),
+              table.equity(CardSet("AcQs"), CardSet("2c7c9cJcKc")));
+
+    EXPECT_GT(0.0, table.equity(CardSet("AhQs"), CardSet("2d7h9hJhKh")));
+    EXPECT_GT(0.0, table.equity(CardSet("AhKh"), CardSet("2h7h9hJhKh")));
+}
+
+TEST(EquityTable, FlopLookup)
+{
+    vector<CardSet> boards(1, CardSet("Qs7d2c"));
+    string filename = testing::TempDir() + "flop.eqt";
+    ASSERT_TRUE(EquityTable::generate(filename, boards));
+
+    EquityTable table;
+    ASSERT_TRUE(table.open(filename));
+    CardSet pocket("AhKd");
+    EXPECT_NEAR(showdownEquity(pocket, CardSet("Qh7s2d")),
+                table.equity(pocket, CardSet("Qh7s2d")), 1e-4);
+    EXPECT_FALSE(table.open(filename + ".missing"));
+    EXPECT_FALSE(table.isOpen());
+}
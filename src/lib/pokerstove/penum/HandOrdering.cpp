@@ -0,0 +1,269 @@
+/**
+ * Copyright (c) 2012 Andrew Prock. All rights reserved.
+ */
+#include "HandOrdering.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <pokerstove/peval/Card.h>
+#include <pokerstove/peval/PokerHandEvaluator.h>
+#include <pokerstove/util/combinations.h>
+#include "ShowdownEnumerator.h"
+
+using namespace std;
+
+namespace pokerstove
+{
+
+namespace
+{
+const char kMagic[4] = {'P', 'S', 'H', 'O'};
+const uint32_t kVersion = 1;
+
+// game names are short codes, longer ones mean a corrupt file
+const uint32_t kMaxGameSize = 64;
+
+// orderings are kept for hold'em and omaha style hands
+bool orderedHandSize(size_t handSize)
+{
+    return handSize == 2 || handSize == 4;
+}
+
+// deal n random cards from the deck which are not in dead
+CardSet dealRandom(mt19937& rng, const vector<Card>& deck, const CardSet& dead, size_t n)
+{
+    uniform_int_distribution<size_t> card(0, deck.size() - 1);
+    CardSet cards;
+    while (cards.size() < n)
+    {
+        Card c = deck[card(rng)];
+        if (!dead.contains(c) && !cards.contains(c))
+            cards.insert(c);
+    }
+    return cards;
+}
+
+template <class T>
+void writeValue(ofstream& out, const T& value)
+{
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <class T>
+bool readValue(ifstream& in, T& value)
+{
+    in.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return in.good();
+}
+}  // namespace
+
+HandOrdering::HandOrdering()
+    : _game()
+    , _handSize(0)
+{}
+
+void HandOrdering::build(const string& game,
+                         size_t boards,
+                         size_t opponents,
+                         unsigned int seed)
+{
+    std::shared_ptr<PokerHandEvaluator> peval = PokerHandEvaluator::alloc(game);
+    if (peval.get() == NULL)
+        throw runtime_error("HandOrdering, unknown game: " + game);
+    if (!orderedHandSize(peval->handSize()))
+        throw runtime_error("HandOrdering, only games with two or four card hands are ordered: " + game);
+
+    _game = game;
+    _handSize = peval->handSize();
+    size_t boardSize = peval->boardSize();
+    if (boardSize == 0)
+        boards = 1;
+
+    // collect the suit isomorphic classes of the game's deck
+    vector<Card> deck = peval->deck().cards();
+    set<CardSet> classes;
+    combinations hands(deck.size(), _handSize);
+    do
+    {
+        CardSet hand;
+        for (size_t i = 0; i < _handSize; i++)
+            hand.insert(deck[hands[i]]);
+        classes.insert(hand.canonize());
+    } while (hands.next());
+
+    mt19937 rng(seed);
+    ShowdownEnumerator showdown;
+    vector<pair<double, CardSet>> ordering;
+    for (const CardSet& hand : classes)
+    {
+        // opponent hands which collide with the board are skipped by the
+        // enumerator, which keeps the sample uniform
+        CardDistribution opp;
+        opp.clear();
+        for (size_t i = 0; i < opponents; i++)
+            opp.insert(dealRandom(rng, deck, hand, _handSize));
+
+        vector<CardDistribution> dists;
+        dists.push_back(CardDistribution(hand));
+        dists.push_back(opp);
+
+        double shares = 0.0;
+        double total = 0.0;
+        for (size_t b = 0; b < boards; b++)
+        {
+            CardSet board = dealRandom(rng, deck, hand, boardSize);
+            vector<EquityResult> results =
+                showdown.calculateEquity(dists, board, peval);
+            shares += results[0].shares();
+            total += results[0].shares() + results[1].shares();
+        }
+        ordering.push_back(make_pair(total > 0.0 ? shares / total : 0.0, hand));
+    }
+
+    // best to worst, ties broken by the card mask to keep builds stable
+    sort(ordering.begin(), ordering.end(),
+         [](const pair<double, CardSet>& a, const pair<double, CardSet>& b) {
+             if (a.first != b.first)
+                 return a.first > b.first;
+             return a.second < b.second;
+         });
+
+    _classes.clear();
+    _equities.clear();
+    for (const pair<double, CardSet>& entry : ordering)
+    {
+        _classes.push_back(entry.second);
+        _equities.push_back(static_cast<float>(entry.first));
+    }
+    index();
+}
+
+bool HandOrdering::save(const string& filename) const
+{
+    ofstream out(filename.c_str(), ios::out | ios::binary);
+    if (!out)
+        return false;
+
+    out.write(kMagic, sizeof(kMagic));
+    writeValue(out, kVersion);
+    writeValue(out, static_cast<uint32_t>(_handSize));
+    writeValue(out, static_cast<uint32_t>(_game.size()));
+    out.write(_game.data(), _game.size());
+    writeValue(out, static_cast<uint32_t>(_classes.size()));
+    for (size_t i = 0; i < _classes.size(); i++)
+    {
+        writeValue(out, _classes[i].mask());
+        writeValue(out, _equities[i]);
+    }
+    return out.good();
+}
+
+bool HandOrdering::load(const string& filename)
+{
+    ifstream in(filename.c_str(), ios::in | ios::binary);
+    if (!in)
+        return false;
+
+    char magic[sizeof(kMagic)];
+    in.read(magic, sizeof(magic));
+    if (!in.good() || memcmp(magic, kMagic, sizeof(kMagic)) != 0)
+        return false;
+
+    uint32_t version, handSize, gameSize, count;
+    if (!readValue(in, version) || version != kVersion)
+        return false;
+    if (!readValue(in, handSize) || !readValue(in, gameSize))
+        return false;
+    if (!orderedHandSize(handSize) || gameSize > kMaxGameSize)
+        return false;
+    string game(gameSize, ' ');
+    in.read(&game[0], gameSize);
+    if (!in.good() || !readValue(in, count))
+        return false;
+    std::shared_ptr<PokerHandEvaluator> peval = PokerHandEvaluator::alloc(game);
+    if (peval.get() == NULL || peval->handSize() != handSize)
+        return false;
+
+    vector<CardSet> classes;
+    vector<float> equities;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        uint64_t mask;
+        float equity;
+        if (!readValue(in, mask) || !readValue(in, equity))
+            return false;
+        if (mask >> STANDARD_DECK_SIZE != 0 || CardSet(mask).size() != handSize)
+            return false;
+        classes.push_back(CardSet(mask));
+        equities.push_back(equity);
+    }
+
+    _game = game;
+    _handSize = handSize;
+    _classes.swap(classes);
+    _equities.swap(equities);
+    index();
+    return true;
+}
+
+void HandOrdering::index()
+{
+    _classIndex.clear();
+    _classHands.clear();
+    if (_classes.empty())
+        return;
+
+    for (size_t i = 0; i < _classes.size(); i++)
+        _classIndex[_classes[i]] = i;
+
+    _classHands.resize(_classes.size());
+    combinations hands(STANDARD_DECK_SIZE, _handSize);
+    do
+    {
+        CardSet hand;
+        for (size_t i = 0; i < _handSize; i++)
+            hand.insert(Card(static_cast<uint8_t>(hands[i])));
+        map<CardSet, size_t>::const_iterator it =
+            _classIndex.find(hand.canonize());
+        if (it != _classIndex.end())
+            _classHands[it->second].push_back(hand);
+    } while (hands.next());
+}
+
+double HandOrdering::equity(const CardSet& hand) const
+{
+    map<CardSet, size_t>::const_iterator it = _classIndex.find(hand.canonize());
+    if (it == _classIndex.end())
+        return -1.0;
+    return _equities[it->second];
+}
+
+CardDistribution HandOrdering::range(double low, double high, double weight) const
+{
+    CardDistribution dist;
+    dist.clear();
+
+    size_t total = 0;
+    for (const vector<CardSet>& hands : _classHands)
+        total += hands.size();
+
+    double lowHands = min(low, high) / 100.0 * total;
+    double highHands = max(low, high) / 100.0 * total;
+    size_t count = 0;
+    for (const vector<CardSet>& hands : _classHands)
+    {
+        if (count >= highHands)
+            break;
+        if (count >= lowHands)
+            for (const CardSet& hand : hands)
+                dist.insert(hand, weight);
+        count += hands.size();
+    }
+    return dist;
+}
+
+}  // namespace pokerstove
@@ -0,0 +1,99 @@
+/**
+ * Copyright (c) 2012 Andrew Prock. All rights reserved.
+ */
+#ifndef PENUM_HANDORDERING_H_
+#define PENUM_HANDORDERING_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include <pokerstove/peval/CardSet.h>
+#include "CardDistribution.h"
+
+namespace pokerstove
+{
+/**
+ * An ordering of all the starting hands of a game, from best to worst, by
+ * equity against a single random hand.  Hands are stored by suit
+ * isomorphic class (CardSet::canonize), so hold'em has 169 entries and
+ * omaha has 16432.
+ *
+ * Orderings are expensive to build but cheap to use, the intended use is
+ * to build them once with ps-order, save them to a file, and then load
+ * them to serve "top N%" distributions.
+ *
+ * The file format is a small header followed by one (canonical mask,
+ * equity) record per class, in best to worst order.  All values are
+ * stored in host byte order.
+ */
+class HandOrdering
+{
+public:
+    HandOrdering();
+
+    /**
+     * Build the ordering for a game.  Each class is played against a
+     * random hand with ShowdownEnumerator over a sample of boards and
+     * opponents, the number of showdowns per class is roughly
+     * boards*opponents.  Games without a board use the opponent samples
+     * only.  A fixed seed makes the ordering reproducible.
+     */
+    void build(const std::string& game,
+               size_t boards,
+               size_t opponents,
+               unsigned int seed = 0);
+
+    /**
+     * false if the file can not be read, or is not an ordering of two
+     * or four card hands
+     */
+    bool load(const std::string& filename);
+    bool save(const std::string& filename) const;
+
+    const std::string& game() const { return _game; }
+    size_t handSize() const { return _handSize; }
+
+    /**
+     * number of hand classes in the ordering
+     */
+    size_t size() const { return _classes.size(); }
+
+    /**
+     * the canonical hand and equity of the i'th best class
+     */
+    const CardSet& hand(size_t i) const { return _classes[i]; }
+    double equity(size_t i) const { return _equities[i]; }
+
+    /**
+     * equity against a random hand of any hand in the game, or a
+     * negative value if the hand is not part of the ordering
+     */
+    double equity(const CardSet& hand) const;
+
+    /**
+     * All hands from the top low% to the top high% of the ordering.  A
+     * class is included if the range has not been filled when it is
+     * reached, so the result always covers at least the requested share
+     * of hands.
+     */
+    CardDistribution range(double low, double high, double weight = 1.0) const;
+    CardDistribution top(double pct) const { return range(0.0, pct); }
+
+private:
+    void index();
+
+    std::string _game;
+    size_t _handSize;
+    std::vector<CardSet> _classes;
+    std::vector<float> _equities;
+
+    // all the hands in each class, built by build() and load() so that
+    // a shared ordering is only ever read
+    std::map<CardSet, size_t> _classIndex;
+    std::vector<std::vector<CardSet>> _classHands;
+};
+
+}  // namespace pokerstove
+
+#endif  // PENUM_HANDORDERING_H_
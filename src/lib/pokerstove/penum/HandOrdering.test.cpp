@@ -0,0 +1,153 @@
+#include "HandOrdering.h"
+#include "RangeDistribution.h"
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <pokerstove/peval/ShortDeckHandEvaluator.h>
+#include <gtest/gtest.h>
+
+using namespace pokerstove;
+using namespace std;
+
+namespace
+{
+// a small sample keeps the test quick, but is enough to separate the
+// hands we check below
+const HandOrdering& holdemOrdering()
+{
+    static HandOrdering ordering;
+    if (ordering.size() == 0)
+        ordering.build("h", 50, 50, 1);
+    return ordering;
+}
+}  // namespace
+
+TEST(HandOrdering, Build)
+{
+    const HandOrdering& ordering = holdemOrdering();
+    EXPECT_EQ(169, ordering.size());
+    EXPECT_EQ(2, ordering.handSize());
+    EXPECT_GT(ordering.equity(CardSet("AcAd")), 0.8);
+    EXPECT_LT(ordering.equity(CardSet("7c2d")), 0.4);
+    EXPECT_GT(ordering.equity(CardSet("AsAh")), ordering.equity(CardSet("7h2h")));
+    for (size_t i = 1; i < ordering.size(); i++)
+        EXPECT_GE(ordering.equity(i - 1), ordering.equity(i));
+}
+
+TEST(HandOrdering, Range)
+{
+    const HandOrdering& ordering = holdemOrdering();
+    EXPECT_EQ(1326, ordering.top(100.0).size());
+    EXPECT_EQ(0, ordering.top(0.0).size());
+
+    CardDistribution top10 = ordering.top(10.0);
+    CardDistribution slice = ordering.range(10.0, 20.0);
+    CardDistribution top20 = ordering.top(20.0);
+    EXPECT_GE(top10.size(), 133);
+    EXPECT_EQ(top20.size(), top10.size() + slice.size());
+    EXPECT_EQ(1.0, top10[CardSet("AcAd")]);
+    EXPECT_EQ(0.0, slice[CardSet("AcAd")]);
+}
+
+TEST(HandOrdering, SaveLoad)
+{
+    const HandOrdering& ordering = holdemOrdering();
+    string filename = testing::TempDir() + "ordering.bin";
+    ASSERT_TRUE(ordering.save(filename));
+
+    HandOrdering loaded;
+    ASSERT_TRUE(loaded.load(filename));
+    EXPECT_EQ("h", loaded.game());
+    EXPECT_EQ(ordering.size(), loaded.size());
+    for (size_t i = 0; i < ordering.size(); i++)
+    {
+        EXPECT_EQ(ordering.hand(i), loaded.hand(i));
+        EXPECT_EQ(ordering.equity(i), loaded.equity(i));
+    }
+    EXPECT_EQ(ordering.top(10.0).size(), loaded.top(10.0).size());
+    EXPECT_EQ(ordering.equity(CardSet("AcAd")), loaded.equity(CardSet("AhAs")));
+    EXPECT_FALSE(loaded.load(filename + ".missing"));
+}
+
+TEST(HandOrdering, ShortDeckSaveLoad)
+{
+    HandOrdering ordering;
+    ordering.build("6", 5, 10, 1);
+    EXPECT_EQ(81, ordering.size());
+    for (size_t i = 0; i < ordering.size(); i++)
+        EXPECT_EQ(ordering.hand(i), ordering.hand(i) & ShortDeckHandEvaluator::shortDeck());
+
+    string filename = testing::TempDir() + "shortdeck.bin";
+    ASSERT_TRUE(ordering.save(filename));
+    HandOrdering loaded;
+    ASSERT_TRUE(loaded.load(filename));
+    remove(filename.c_str());
+    EXPECT_EQ("6", loaded.game());
+    EXPECT_EQ(ordering.size(), loaded.size());
+    EXPECT_EQ(630, loaded.top(100.0).size());
+    EXPECT_EQ(ordering.equity(CardSet("AcKc")), loaded.equity(CardSet("AdKd")));
+}
+
+TEST(HandOrdering, BuildRejectsGames)
+{
+    HandOrdering ordering;
+    EXPECT_THROW(ordering.build("3", 1, 1), runtime_error);
+    EXPECT_THROW(ordering.build("x", 1, 1), runtime_error);
+}
+
+TEST(HandOrdering, LoadRejectsBadHands)
+{
+    const HandOrdering& ordering = holdemOrdering();
+    string filename = testing::TempDir() + "ordering.bin";
+
+    // the hand size follows the magic and version, and the first class
+    // follows the hand size, the one letter game, and the class count
+    const streamoff handSizeAt = 4 + 4;
+    const streamoff firstClassAt = handSizeAt + 4 + 4 + 1 + 4;
+
+    ASSERT_TRUE(ordering.save(filename));
+    {
+        fstream file(filename.c_str(), ios::in | ios::out | ios::binary);
+        uint32_t handSize = 3;
+        file.seekp(handSizeAt);
+        file.write(reinterpret_cast<const char*>(&handSize), sizeof(handSize));
+    }
+    HandOrdering loaded;
+    EXPECT_FALSE(loaded.load(filename));
+
+    ASSERT_TRUE(ordering.save(filename));
+    {
+        fstream file(filename.c_str(), ios::in | ios::out | ios::binary);
+        uint64_t mask = CardSet("AcAdAh").mask();
+        file.seekp(firstClassAt);
+        file.write(reinterpret_cast<const char*>(&mask), sizeof(mask));
+    }
+    EXPECT_FALSE(loaded.load(filename));
+
+    // a game name far longer than any game
+    ASSERT_TRUE(ordering.save(filename));
+    {
+        fstream file(filename.c_str(), ios::in | ios::out | ios::binary);
+        uint32_t gameSize = 0xFFFFFFFF;
+        file.seekp(handSizeAt + 4);
+        file.write(reinterpret_cast<const char*>(&gameSize), sizeof(gameSize));
+    }
+    EXPECT_FALSE(loaded.load(filename));
+    remove(filename.c_str());
+}
+
+TEST(HandOrdering, RangeDistribution)
+{
+    std::shared_ptr<HandOrdering> ordering(new HandOrdering(holdemOrdering()));
+    RangeDistribution dist;
+    dist.setOrdering(ordering);
+    EXPECT_TRUE(dist.parse("100%"));
+    EXPECT_EQ(1326, dist.size());
+    EXPECT_TRUE(dist.parse("5%-10%"));
+    EXPECT_EQ(ordering->range(5.0, 10.0).size(), dist.size());
+
+    // orderings only apply to games with the same hand size
+    RangeDistribution omaha(4);
+    omaha.setOrdering(ordering);
+    EXPECT_FALSE(omaha.parse("10%"));
+}
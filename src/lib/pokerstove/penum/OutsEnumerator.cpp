@@ -0,0 +1,134 @@
+/**
+ * Copyright (c) 2012 Andrew Prock. All rights reserved.
+ */
+#include "OutsEnumerator.h"
+
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+#include "DisjointOdometer.h"
+#include <pokerstove/peval/PokerHandEvaluation.h>
+
+using namespace std;
+
+namespace pokerstove
+{
+
+OutsEnumerator::OutsEnumerator()
+    : _dead()
+{}
+
+vector<OutsResult>
+OutsEnumerator::calculateOuts(const CardSet& hand,
+                              const vector<CardDistribution>& opponents,
+                              const CardSet& board,
+                              std::shared_ptr<PokerHandEvaluator> peval) const
+{
+    if (opponents.empty())
+        throw runtime_error("OutsEnumerator, no opponents");
+    if (hand.size() != peval->handSize())
+        throw runtime_error("OutsEnumerator, hand does not fit the game: " + hand.str());
+    if (board.size() >= peval->boardSize())
+        throw runtime_error("OutsEnumerator, no cards left to come on the board");
+    if (board.size() + 2 < peval->boardSize())
+        throw runtime_error("OutsEnumerator, outs are for the flop and the turn");
+    if (hand.intersects(board) || _dead.intersects(hand | board))
+        throw runtime_error("OutsEnumerator, hand, board, and dead cards collide");
+    CardSet known = hand | board | _dead;
+
+    vector<Card> cards = (peval->deck() ^ (peval->deck() & known)).cards();
+    const size_t ncards = cards.size();
+
+    // the hand, and each distinct opponent hand, evaluated on the current
+    // board and with each live card
+    vector<PokerEvaluation> heroEvals(ncards + 1);
+    for (size_t k = 0; k < ncards; k++)
+        heroEvals[k] = peval->evaluateHand(hand, board | CardSet(cards[k])).high();
+    heroEvals[ncards] = peval->evaluateHand(hand, board).high();
+
+    map<uint64_t, size_t> distinct;
+    vector<vector<size_t>> slots(opponents.size());
+    vector<PokerEvaluation> evals;
+    for (size_t i = 0; i < opponents.size(); i++)
+        for (size_t h = 0; h < opponents[i].size(); h++)
+        {
+            const CardSet& opp = opponents[i][h];
+            slots[i].push_back(0);
+            if (opp.intersects(known))
+                continue;
+            map<uint64_t, size_t>::const_iterator it = distinct.find(opp.mask());
+            if (it != distinct.end())
+            {
+                slots[i].back() = it->second;
+                continue;
+            }
+            size_t slot = evals.size();
+            distinct[opp.mask()] = slot;
+            slots[i].back() = slot;
+            evals.resize(slot + ncards + 1);
+            for (size_t k = 0; k < ncards; k++)
+                if (!opp.contains(cards[k]))
+                    evals[slot + k] =
+                        peval->evaluateHand(opp, board | CardSet(cards[k])).high();
+            evals[slot + ncards] = peval->evaluateHand(opp, board).high();
+        }
+
+    vector<OutsResult> results(ncards);
+    for (size_t k = 0; k < ncards; k++)
+        results[k].card = cards[k];
+
+    DisjointOdometer o(opponents, known);
+    vector<size_t> tuple(opponents.size());
+    for (bool more = o.valid(); more; more = o.next())
+    {
+        double weight = 1.0;
+        CardSet used;
+        for (size_t i = 0; i < opponents.size(); i++)
+        {
+            const CardSet& opp = opponents[i][o[i]];
+            weight *= opponents[i][opp];
+            used |= opp;
+            tuple[i] = slots[i][o[i]];
+        }
+        if (weight <= 0.0)
+            continue;
+
+        PokerEvaluation best = evals[tuple[0] + ncards];
+        for (size_t i = 1; i < tuple.size(); i++)
+            best = max(best, evals[tuple[i] + ncards]);
+        bool ahead = heroEvals[ncards] > best;
+
+        for (size_t k = 0; k < ncards; k++)
+        {
+            if (used.contains(cards[k]))
+                continue;
+            PokerEvaluation next = evals[tuple[0] + k];
+            for (size_t i = 1; i < tuple.size(); i++)
+                next = max(next, evals[tuple[i] + k]);
+            bool aheadAfter = heroEvals[k] > next;
+
+            OutsResult& r = results[k];
+            r.weight += weight;
+            if (ahead)
+                r.before += weight;
+            if (aheadAfter)
+                r.after += weight;
+            if (aheadAfter && !ahead)
+                r.gained += weight;
+            if (ahead && !aheadAfter)
+                r.lost += weight;
+        }
+    }
+    return results;
+}
+
+vector<OutsResult> OutsEnumerator::outs(const vector<OutsResult>& results)
+{
+    vector<OutsResult> ret;
+    for (const OutsResult& r : results)
+        if (r.isOut())
+            ret.push_back(r);
+    return ret;
+}
+
+}  // namespace pokerstove
@@ -0,0 +1,94 @@
+/**
+ * Copyright (c) 2012 Andrew Prock. All rights reserved.
+ */
+#ifndef PENUM_OUTSENUMERATOR_H_
+#define PENUM_OUTSENUMERATOR_H_
+
+#include <memory>
+#include <vector>
+#include "CardDistribution.h"
+#include <pokerstove/peval/Card.h>
+#include <pokerstove/peval/PokerHandEvaluator.h>
+
+namespace pokerstove
+{
+/**
+ * How one next card changes the lead between a hand and its opponents.
+ * Weights are summed over the tuples of opponent hands which leave the
+ * card live, each tuple weighted by the product of its hand weights.  A
+ * hand is ahead of a tuple if its evaluation beats every opponent's, a
+ * tie is not ahead.
+ */
+struct OutsResult
+{
+    Card card;
+    double weight;  //!< weight of the tuples which leave the card live
+    double before;  //!< weight the hand is ahead of on the current board
+    double after;   //!< weight the hand is ahead of after the card
+    double gained;  //!< weight the hand was not ahead of, and is after the card
+    double lost;    //!< weight the hand was ahead of, and is not after the card
+
+    OutsResult()
+        : card()
+        , weight(0.0)
+        , before(0.0)
+        , after(0.0)
+        , gained(0.0)
+        , lost(0.0)
+    {}
+
+    /**
+     * the card puts the hand ahead of some of the opponents' holdings
+     */
+    bool isOut() const { return gained > 0.0; }
+
+    double gainedFraction() const { return weight > 0.0 ? gained / weight : 0.0; }
+    double lostFraction() const { return weight > 0.0 ? lost / weight : 0.0; }
+};
+
+/**
+ * Outs of a hand against one or more opponent distributions on a flop
+ * or turn: for every live next card, the weight of the opponent holdings
+ * the card takes the lead from, or gives it to.  Split pot games use
+ * the high half.
+ *
+ * Everything is done in one pass.  Each distinct opponent hand is
+ * evaluated once on the current board and once per live card, however
+ * many distributions hold it, then the disjoint tuples of opponent
+ * hands are walked once, and every live card is scored from the stored
+ * evaluations.
+ */
+class OutsEnumerator
+{
+public:
+    OutsEnumerator();
+
+    /**
+     * cards known to be out of the deck
+     */
+    void setDead(const CardSet& dead) { _dead = dead; }
+    const CardSet& dead() const { return _dead; }
+
+    /**
+     * One result for each live next card, in card order.  Throws a
+     * runtime_error if the hand or board do not fit the game, or the
+     * board is not a flop or a turn.
+     */
+    std::vector<OutsResult>
+    calculateOuts(const CardSet& hand,
+                  const std::vector<CardDistribution>& opponents,
+                  const CardSet& board,
+                  std::shared_ptr<PokerHandEvaluator> peval) const;
+
+    /**
+     * the results which are outs for the hand
+     */
+    static std::vector<OutsResult> outs(const std::vector<OutsResult>& results);
+
+private:
+    CardSet _dead;
+};
+
+}  // namespace pokerstove
+
+#endif  // PENUM_OUTSENUMERATOR_H_
@@ -0,0 +1,123 @@
+#include "OutsEnumerator.h"
+#include "RangeDistribution.h"
+#include <stdexcept>
+#include <gtest/gtest.h>
+
+using namespace pokerstove;
+using namespace std;
+
+namespace
+{
+/**
+ * the same counts, from a full evaluation of every pair of opponent hands
+ */
+vector<OutsResult> bruteForce(const CardSet& hand,
+                              const vector<CardDistribution>& opponents,
+                              const CardSet& board,
+                              std::shared_ptr<PokerHandEvaluator> peval)
+{
+    CardSet deck;
+    deck.fill();
+    vector<OutsResult> results;
+    for (const Card& c : (deck ^ (hand | board)).cards())
+    {
+        OutsResult r;
+        r.card = c;
+        CardSet next = board | CardSet(c);
+        for (size_t i = 0; i < opponents[0].size(); i++)
+            for (size_t j = 0; j < opponents[1].size(); j++)
+            {
+                const CardSet& a = opponents[0][i];
+                const CardSet& b = opponents[1][j];
+                if (a.intersects(b) || (a | b).intersects(next | hand))
+                    continue;
+                double w = opponents[0][a] * opponents[1][b];
+                bool before = peval->evaluateHand(hand, board).high() >
+                              max(peval->evaluateHand(a, board).high(),
+                                  peval->evaluateHand(b, board).high());
+                bool after = peval->evaluateHand(hand, next).high() >
+                             max(peval->evaluateHand(a, next).high(),
+                                 peval->evaluateHand(b, next).high());
+                r.weight += w;
+                r.gained += (after && !before) ? w : 0.0;
+                r.lost += (before && !after) ? w : 0.0;
+            }
+        results.push_back(r);
+    }
+    return results;
+}
+}  // namespace
+
+TEST(OutsEnumerator, FlushDrawAgainstSet)
+{
+    std::shared_ptr<PokerHandEvaluator> peval = PokerHandEvaluator::alloc("h");
+    vector<CardDistribution> opponents(1, CardDistribution(CardSet("QcQd")));
+
+    OutsEnumerator outs;
+    vector<OutsResult> results =
+        outs.calculateOuts(CardSet("AhKh"), opponents, CardSet("Qh7h2c"), peval);
+    EXPECT_EQ(47, results.size());
+
+    // the deuce of hearts fills up the set
+    vector<OutsResult> hits = OutsEnumerator::outs(results);
+    EXPECT_EQ(CardSet("3h4h5h6h8h9hThJh").size(), hits.size());
+    for (const OutsResult& r : hits)
+    {
+        EXPECT_EQ(Suit::Hearts(), r.card.suit());
+        EXPECT_EQ(1.0, r.gainedFraction());
+        EXPECT_EQ(0.0, r.before);
+        EXPECT_EQ(0.0, r.lost);
+    }
+}
+
+TEST(OutsEnumerator, MatchesFullEvaluation)
+{
+    std::shared_ptr<PokerHandEvaluator> peval = PokerHandEvaluator::alloc("h");
+    RangeDistribution first, second;
+    ASSERT_TRUE(first.parse("QQ+,AK,77=0.5"));
+    ASSERT_TRUE(second.parse("98s,T9s,QQ,A2s=2"));
+    vector<CardDistribution> opponents;
+    opponents.push_back(first.data());
+    opponents.push_back(second.data());
+
+    CardSet hand("JcTc");
+    CardSet board("9c8d2h");
+    OutsEnumerator outs;
+    vector<OutsResult> results = outs.calculateOuts(hand, opponents, board, peval);
+    vector<OutsResult> expected = bruteForce(hand, opponents, board, peval);
+    ASSERT_EQ(expected.size(), results.size());
+    EXPECT_FALSE(OutsEnumerator::outs(results).empty());
+    for (size_t k = 0; k < results.size(); k++)
+    {
+        EXPECT_EQ(expected[k].card, results[k].card);
+        EXPECT_DOUBLE_EQ(expected[k].weight, results[k].weight);
+        EXPECT_DOUBLE_EQ(expected[k].gained, results[k].gained) << results[k].card.str();
+        EXPECT_DOUBLE_EQ(expected[k].lost, results[k].lost) << results[k].card.str();
+    }
+}
+
+TEST(OutsEnumerator, InvalidInput)
+{
+    std::shared_ptr<PokerHandEvaluator> peval = PokerHandEvaluator::alloc("h");
+    vector<CardDistribution> opponents(1, CardDistribution(CardSet("QcQd")));
+    OutsEnumerator outs;
+    EXPECT_THROW(outs.calculateOuts(CardSet("AhKh"), opponents,
+                                    CardSet("Qh7h2c3c4c"), peval),
+                 runtime_error);
+    EXPECT_THROW(outs.calculateOuts(CardSet("AhKh"), opponents, CardSet(), peval),
+                 runtime_error);
+    EXPECT_THROW(outs.calculateOuts(CardSet("AhKh"), opponents, CardSet("Qh7h"), peval),
+                 runtime_error);
+    EXPECT_THROW(outs.calculateOuts(CardSet("AhKh"), opponents,
+                                    CardSet("Kh7h2c"), peval),
+                 runtime_error);
+    EXPECT_THROW(outs.calculateOuts(CardSet("AhKh"), vector<CardDistribution>(),
+                                    CardSet("Qh7h2c"), peval),
+                 runtime_error);
+
+    // dead cards are not dealt
+    outs.setDead(CardSet("3h"));
+    EXPECT_EQ(46, outs.calculateOuts(CardSet("AhKh"), opponents,
+                                     CardSet("Qh7h2c"), peval)
+                      .size());
+}
@@ -0,0 +1,290 @@
+/**
+ * Copyright (c) 2012 Andrew Prock. All rights reserved.
+ */
+#include "PartialEquity.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+using namespace std;
+
+namespace pokerstove
+{
+
+namespace
+{
+const char kMagic[4] = {'P', 'S', 'P', 'E'};
+const uint32_t kVersion = 2;
+
+// 64 bit FNV-1a
+uint64_t hashString(uint64_t hash, const string& s)
+{
+    for (unsigned char c : s)
+    {
+        hash ^= c;
+        hash *= UINT64_C(0x100000001b3);
+    }
+    return hash;
+}
+
+uint64_t hashValue(uint64_t hash, uint64_t value)
+{
+    for (int i = 0; i < 8; i++)
+    {
+        hash ^= (value >> (8 * i)) & 0xFF;
+        hash *= UINT64_C(0x100000001b3);
+    }
+    return hash;
+}
+
+template <class T>
+void writeValue(ofstream& out, const T& value)
+{
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <class T>
+bool readValue(ifstream& in, T& value)
+{
+    in.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return in.good();
+}
+
+// merge touching ranges, the input must be sorted and disjoint
+vector<PartialEquity::Range> coalesce(const vector<PartialEquity::Range>& ranges)
+{
+    vector<PartialEquity::Range> ret;
+    for (const PartialEquity::Range& r : ranges)
+    {
+        if (r.first == r.second)
+            continue;
+        if (!ret.empty() && ret.back().second == r.first)
+            ret.back().second = r.second;
+        else
+            ret.push_back(r);
+    }
+    return ret;
+}
+
+bool overlaps(const vector<PartialEquity::Range>& sorted)
+{
+    for (size_t i = 1; i < sorted.size(); i++)
+        if (sorted[i].first < sorted[i - 1].second)
+            return true;
+    return false;
+}
+
+// what save writes: non-empty, sorted, disjoint, and within [0,total)
+bool validRanges(const vector<PartialEquity::Range>& ranges, uint64_t total)
+{
+    for (size_t i = 0; i < ranges.size(); i++)
+    {
+        if (ranges[i].first >= ranges[i].second || ranges[i].second > total)
+            return false;
+        if (i > 0 && ranges[i].first < ranges[i - 1].second)
+            return false;
+    }
+    return true;
+}
+}  // namespace
+
+PartialEquity::PartialEquity()
+    : _fingerprint(0)
+    , _total(0)
+    , _exact(false)
+{}
+
+PartialEquity::PartialEquity(uint64_t fingerprint,
+                             uint64_t total,
+                             size_t players,
+                             bool exact)
+    : _fingerprint(fingerprint)
+    , _total(total)
+    , _exact(exact)
+    , _results(players, EquityResult())
+    , _exactResults(players)
+{}
+
+uint64_t PartialEquity::fingerprint(const vector<CardDistribution>& dists,
+                                    const CardSet& board,
+                                    const PokerHandEvaluator& peval)
+{
+    uint64_t hash = UINT64_C(0xcbf29ce484222325);
+    hash = hashString(hash, peval.id() + "|" + board.str());
+    // the raw weights, so distributions which print the same still differ
+    for (const CardDistribution& dist : dists)
+    {
+        hash = hashString(hash, "|");
+        for (size_t i = 0; i < dist.size(); i++)
+        {
+            double weight = dist[dist[i]];
+            uint64_t bits;
+            memcpy(&bits, &weight, sizeof(bits));
+            hash = hashValue(hashValue(hash, dist[i].mask()), bits);
+        }
+    }
+    return hash;
+}
+
+vector<PartialEquity::Range> PartialEquity::split(uint64_t total, size_t n)
+{
+    vector<Range> units;
+    uint64_t begin = 0;
+    for (size_t i = 0; i < n; i++)
+    {
+        uint64_t end = total / n * (i + 1) + min<uint64_t>(i + 1, total % n);
+        units.push_back(Range(begin, end));
+        begin = end;
+    }
+    return units;
+}
+
+uint64_t PartialEquity::covered() const
+{
+    uint64_t count = 0;
+    for (const Range& r : _ranges)
+        count += r.second - r.first;
+    return count;
+}
+
+bool PartialEquity::cover(uint64_t begin, uint64_t end)
+{
+    if (begin > end || end > _total)
+        return false;
+    vector<Range> ranges = _ranges;
+    ranges.push_back(Range(begin, end));
+    sort(ranges.begin(), ranges.end());
+    if (overlaps(ranges))
+        return false;
+    _ranges = coalesce(ranges);
+    return true;
+}
+
+vector<EquityResult> PartialEquity::equities() const
+{
+    if (_exact)
+        return ExactEquityResult::results(_exactResults);
+    vector<EquityResult> ret = _results;
+    EquityResult::normalize(ret);
+    return ret;
+}
+
+bool PartialEquity::merge(const PartialEquity& other)
+{
+    if (other._fingerprint != _fingerprint || other._total != _total ||
+        other._exact != _exact || other.size() != size())
+        return false;
+
+    vector<Range> ranges = _ranges;
+    ranges.insert(ranges.end(), other._ranges.begin(), other._ranges.end());
+    sort(ranges.begin(), ranges.end());
+    if (overlaps(ranges))
+        return false;
+    _ranges = coalesce(ranges);
+
+    for (size_t i = 0; i < size(); i++)
+    {
+        _results[i] += other._results[i];
+        _exactResults[i] += other._exactResults[i];
+    }
+    if (_labels.empty())
+        _labels = other._labels;
+    return true;
+}
+
+bool PartialEquity::save(const string& filename) const
+{
+    ofstream out(filename.c_str(), ios::out | ios::binary);
+    if (!out)
+        return false;
+
+    out.write(kMagic, sizeof(kMagic));
+    writeValue(out, kVersion);
+    writeValue(out, _fingerprint);
+    writeValue(out, _total);
+    writeValue(out, static_cast<uint32_t>(size()));
+    writeValue(out, static_cast<uint32_t>(_exact ? 1 : 0));
+    writeValue(out, static_cast<uint32_t>(_ranges.size()));
+    for (const Range& r : _ranges)
+    {
+        writeValue(out, r.first);
+        writeValue(out, r.second);
+    }
+    for (size_t i = 0; i < size(); i++)
+    {
+        string label = (i < _labels.size()) ? _labels[i] : "";
+        writeValue(out, static_cast<uint32_t>(label.size()));
+        out.write(label.data(), label.size());
+    }
+    for (size_t i = 0; i < size(); i++)
+    {
+        writeValue(out, _results[i].winShares);
+        writeValue(out, _results[i].tieShares);
+        writeValue(out, _exactResults[i].winUnits);
+        writeValue(out, _exactResults[i].tieUnits);
+    }
+    return out.good();
+}
+
+bool PartialEquity::load(const string& filename)
+{
+    ifstream in(filename.c_str(), ios::in | ios::binary | ios::ate);
+    if (!in)
+        return false;
+    const streamoff size = in.tellg();
+    in.seekg(0);
+
+    char magic[sizeof(kMagic)];
+    in.read(magic, sizeof(magic));
+    if (!in.good() || memcmp(magic, kMagic, sizeof(kMagic)) != 0)
+        return false;
+
+    uint32_t version, players, exact, nranges;
+    PartialEquity part;
+    if (!readValue(in, version) || version != kVersion)
+        return false;
+    if (!readValue(in, part._fingerprint) || !readValue(in, part._total) ||
+        !readValue(in, players) || !readValue(in, exact) ||
+        !readValue(in, nranges))
+        return false;
+    if (players == 0 || players > ShowdownTally::MAX_PLAYERS)
+        return false;
+    part._exact = (exact != 0);
+
+    for (uint32_t i = 0; i < nranges; i++)
+    {
+        Range r;
+        if (!readValue(in, r.first) || !readValue(in, r.second))
+            return false;
+        part._ranges.push_back(r);
+    }
+    if (!validRanges(part._ranges, part._total))
+        return false;
+    for (uint32_t i = 0; i < players; i++)
+    {
+        uint32_t length;
+        if (!readValue(in, length) || length > size - in.tellg())
+            return false;
+        string label(length, ' ');
+        in.read(&label[0], length);
+        if (!in.good() && length > 0)
+            return false;
+        part._labels.push_back(label);
+    }
+    part._results.assign(players, EquityResult());
+    part._exactResults.assign(players, ExactEquityResult());
+    for (uint32_t i = 0; i < players; i++)
+    {
+        if (!readValue(in, part._results[i].winShares) ||
+            !readValue(in, part._results[i].tieShares) ||
+            !readValue(in, part._exactResults[i].winUnits) ||
+            !readValue(in, part._exactResults[i].tieUnits))
+            return false;
+    }
+
+    *this = part;
+    return true;
+}
+
+}  // namespace pokerstove
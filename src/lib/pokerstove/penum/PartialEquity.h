@@ -0,0 +1,126 @@
+/**
+ * Copyright (c) 2012 Andrew Prock. All rights reserved.
+ */
+#ifndef PENUM_PARTIALEQUITY_H_
+#define PENUM_PARTIALEQUITY_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include <pokerstove/peval/PokerHandEvaluator.h>
+#include <pokerstove/peval/ShowdownTally.h>
+#include "CardDistribution.h"
+
+namespace pokerstove
+{
+/**
+ * The results of part of an enumeration, for splitting one
+ * calculateEquity run across processes or machines.
+ *
+ * The showdowns of an enumeration are numbered in the order the
+ * ShowdownEnumerator visits them, and a work unit is a range
+ * [begin,end) of those numbers.  Each unit is run with
+ * ShowdownEnumerator::calculatePartialEquity, saved, and the partial
+ * results are merged back together, ps-merge does this from the command
+ * line.
+ *
+ * A partial result records the fingerprint of the enumeration it came
+ * from, so that only parts of the same problem are merged, and the
+ * ranges it covers, so that overlaps are refused and gaps are reported.
+ * Exact results (see ExactEquityResult) merge bit for bit regardless of
+ * the order the parts are combined in.
+ *
+ * File layout, all values in host byte order:
+ *
+ *   header     "PSPE", version, fingerprint, total showdowns, players,
+ *              exact flag, number of ranges
+ *   ranges     (uint64 begin, uint64 end) per range
+ *   labels     (uint32 length, chars) per player
+ *   results    (double win, double tie, uint64 win, uint64 tie) per
+ *              player, the units are zero unless the result is exact
+ */
+class PartialEquity
+{
+public:
+    typedef std::pair<uint64_t, uint64_t> Range;
+
+    PartialEquity();
+    PartialEquity(uint64_t fingerprint, uint64_t total, size_t players, bool exact);
+
+    /**
+     * identifies an enumeration by its evaluator, board and distributions,
+     * with the hands and exact weights of each distribution
+     */
+    static uint64_t fingerprint(const std::vector<CardDistribution>& dists,
+                                const CardSet& board,
+                                const PokerHandEvaluator& peval);
+
+    /**
+     * n contiguous work units which together cover [0,total), as evenly
+     * sized as possible
+     */
+    static std::vector<Range> split(uint64_t total, size_t n);
+
+    uint64_t fingerprint() const { return _fingerprint; }
+    uint64_t total() const { return _total; }
+    size_t size() const { return _results.size(); }
+    bool exact() const { return _exact; }
+
+    /**
+     * the ranges of showdowns covered, sorted and disjoint
+     */
+    const std::vector<Range>& ranges() const { return _ranges; }
+    uint64_t covered() const;
+    bool complete() const { return covered() == _total; }
+
+    /**
+     * mark a range as covered, false if it overlaps what is already
+     * covered or lies outside the enumeration
+     */
+    bool cover(uint64_t begin, uint64_t end);
+
+    std::vector<EquityResult>& results() { return _results; }
+    const std::vector<EquityResult>& results() const { return _results; }
+    std::vector<ExactEquityResult>& exactResults() { return _exactResults; }
+    const std::vector<ExactEquityResult>& exactResults() const { return _exactResults; }
+
+    /**
+     * normalized equities of what has been covered so far
+     */
+    std::vector<EquityResult> equities() const;
+
+    /**
+     * optional names for the players, used when printing merged results
+     */
+    const std::vector<std::string>& labels() const { return _labels; }
+    void setLabels(const std::vector<std::string>& labels) { _labels = labels; }
+
+    /**
+     * add another part of the same enumeration, false if it is from a
+     * different enumeration or overlaps this one, in which case nothing
+     * is changed
+     */
+    bool merge(const PartialEquity& other);
+
+    /**
+     * load returns false for files which can not be read, or whose
+     * ranges are not sorted, disjoint, and within the total
+     */
+    bool save(const std::string& filename) const;
+    bool load(const std::string& filename);
+
+private:
+    uint64_t _fingerprint;
+    uint64_t _total;
+    bool _exact;
+    std::vector<Range> _ranges;
+    std::vector<std::string> _labels;
+    std::vector<EquityResult> _results;
+    std::vector<ExactEquityResult> _exactResults;
+};
+
+}  // namespace pokerstove
+
+#endif  // PENUM_PARTIALEQUITY_H_
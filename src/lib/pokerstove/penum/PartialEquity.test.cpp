@@ -0,0 +1,224 @@
+#include "PartialEquity.h"
+#include "EnumerationMonitor.h"
+#include "RangeDistribution.h"
+#include "ShowdownEnumerator.h"
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+
+using namespace pokerstove;
+using namespace std;
+
+namespace
+{
+vector<CardDistribution> threeWay()
+{
+    RangeDistribution a, b;
+    a.parse("QQ+,AK");
+    b.parse("JJ,AQs");
+    vector<CardDistribution> dists;
+    dists.push_back(a.data());
+    dists.push_back(b.data());
+    dists.push_back(CardDistribution(CardSet("9h8h")));
+    return dists;
+}
+}  // namespace
+
+TEST(PartialEquity, Split)
+{
+    vector<PartialEquity::Range> units = PartialEquity::split(10, 3);
+    ASSERT_EQ(3, units.size());
+    EXPECT_EQ(PartialEquity::Range(0, 4), units[0]);
+    EXPECT_EQ(PartialEquity::Range(4, 7), units[1]);
+    EXPECT_EQ(PartialEquity::Range(7, 10), units[2]);
+}
+
+TEST(PartialEquity, UnitsAddUp)
+{
+    std::shared_ptr<PokerHandEvaluator> peval = PokerHandEvaluator::alloc("h");
+    vector<CardDistribution> dists = threeWay();
+    CardSet board("Ts7h2c");
+
+    ShowdownEnumerator showdown;
+    uint64_t total = showdown.countShowdowns(dists, board, peval);
+    vector<ExactEquityResult> expected =
+        showdown.calculateExactEquity(dists, board, peval);
+    uint64_t units = 0;
+    for (const ExactEquityResult& e : expected)
+        units += e.units();
+    EXPECT_EQ(total * ExactEquityResult::UNITS_PER_POT, units);
+
+    // merged in any order, the parts give the full result exactly
+    vector<PartialEquity::Range> slices = PartialEquity::split(total, 5);
+    PartialEquity merged;
+    for (size_t i = slices.size(); i-- > 0;)
+    {
+        PartialEquity part = showdown.calculatePartialEquity(
+            dists, board, peval, slices[i].first, slices[i].second, true);
+        EXPECT_EQ(slices[i].second - slices[i].first, part.covered());
+        if (i == slices.size() - 1)
+            merged = part;
+        else
+            ASSERT_TRUE(merged.merge(part));
+    }
+    EXPECT_TRUE(merged.complete());
+    for (size_t i = 0; i < expected.size(); i++)
+        EXPECT_EQ(expected[i], merged.exactResults()[i]);
+
+    // overlapping parts are refused
+    PartialEquity again = showdown.calculatePartialEquity(dists, board, peval, 0, 10, true);
+    EXPECT_FALSE(merged.merge(again));
+}
+
+TEST(PartialEquity, ResumeProgress)
+{
+    std::shared_ptr<PokerHandEvaluator> peval = PokerHandEvaluator::alloc("h");
+    vector<CardDistribution> dists = threeWay();
+    CardSet board("Ts7h2c");
+
+    // a work unit reports its share of the whole enumeration
+    ShowdownEnumerator showdown;
+    uint64_t total = showdown.countShowdowns(dists, board, peval);
+    EnumerationMonitor first;
+    PartialEquity part = showdown.calculatePartialEquity(
+        dists, board, peval, 0, total / 2, false, &first);
+    EXPECT_DOUBLE_EQ(static_cast<double>(total / 2) / total, first.fraction());
+
+    // resuming carries on from there, and publishes the results of both
+    // pieces
+    EnumerationMonitor second;
+    showdown.resumePartialEquity(part, dists, board, peval, 0,
+                                 ShowdownEnumerator::ALL_SHOWDOWNS, &second);
+    EXPECT_EQ(1.0, second.fraction());
+    vector<EquityResult> expected = showdown.calculateEquity(dists, board, peval);
+    vector<EquityResult> published = second.results();
+    ASSERT_EQ(expected.size(), published.size());
+    for (size_t i = 0; i < expected.size(); i++)
+        EXPECT_NEAR(expected[i].shares(), published[i].shares(), 1e-6);
+
+    // a resumed run which stops at once is no further back than the part
+    // it continues
+    PartialEquity half = showdown.calculatePartialEquity(dists, board, peval, 0, total / 2);
+    EnumerationMonitor stopped;
+    stopped.cancel();
+    showdown.resumePartialEquity(half, dists, board, peval, 0,
+                                 ShowdownEnumerator::ALL_SHOWDOWNS, &stopped);
+    EXPECT_GE(stopped.fraction(), static_cast<double>(total / 2) / total);
+    EXPECT_DOUBLE_EQ(static_cast<double>(half.covered()) / total, stopped.fraction());
+}
+
+TEST(PartialEquity, SaveAndLoad)
+{
+    std::shared_ptr<PokerHandEvaluator> peval = PokerHandEvaluator::alloc("h");
+    vector<CardDistribution> dists = threeWay();
+    CardSet board("Ts7h2c");
+
+    ShowdownEnumerator showdown;
+    PartialEquity part =
+        showdown.calculatePartialEquity(dists, board, peval, 100, 5000);
+    vector<string> labels = {"QQ+,AK", "JJ,AQs", "9h8h"};
+    part.setLabels(labels);
+
+    string filename = ::testing::TempDir() + "partial.pspe";
+    ASSERT_TRUE(part.save(filename));
+    PartialEquity loaded;
+    ASSERT_TRUE(loaded.load(filename));
+    remove(filename.c_str());
+
+    EXPECT_EQ(part.fingerprint(), loaded.fingerprint());
+    EXPECT_EQ(part.total(), loaded.total());
+    EXPECT_FALSE(loaded.exact());
+    EXPECT_EQ(part.ranges(), loaded.ranges());
+    EXPECT_EQ(labels, loaded.labels());
+    for (size_t i = 0; i < part.size(); i++)
+    {
+        EXPECT_EQ(part.results()[i].winShares, loaded.results()[i].winShares);
+        EXPECT_EQ(part.results()[i].tieShares, loaded.results()[i].tieShares);
+    }
+
+    // a different problem has a different fingerprint
+    dists[2] = CardDistribution(CardSet("9h7d"));
+    EXPECT_NE(part.fingerprint(), PartialEquity::fingerprint(dists, board, *peval));
+}
+
+TEST(PartialEquity, FingerprintUsesRawWeights)
+{
+    std::shared_ptr<PokerHandEvaluator> peval = PokerHandEvaluator::alloc("h");
+    CardSet board("Ts7h2c");
+    vector<CardDistribution> dists = threeWay();
+    uint64_t fingerprint = PartialEquity::fingerprint(dists, board, *peval);
+
+    // a weight change too small to show in the printed distribution
+    dists[0][dists[0][0]] += 0.0001;
+    EXPECT_NE(fingerprint, PartialEquity::fingerprint(dists, board, *peval));
+}
+
+TEST(PartialEquity, LoadRejectsBadRanges)
+{
+    PartialEquity part(1, 1000, 2, false);
+    ASSERT_TRUE(part.cover(100, 200));
+    ASSERT_TRUE(part.cover(300, 400));
+    string filename = ::testing::TempDir() + "ranges.pspe";
+    ASSERT_TRUE(part.save(filename));
+    PartialEquity good;
+    ASSERT_TRUE(good.load(filename));
+    EXPECT_EQ(part.ranges(), good.ranges());
+
+    // the two ranges follow the magic, version, fingerprint, total,
+    // players, exact flag and range count
+    const streamoff rangesAt = 4 + 4 + 8 + 8 + 4 + 4 + 4;
+    vector<vector<uint64_t>> bad = {
+        {200, 100, 300, 400},   // backwards
+        {100, 350, 300, 400},   // overlapping
+        {300, 400, 100, 200},   // out of order
+        {100, 200, 300, 2000},  // past the total
+    };
+    for (const vector<uint64_t>& ranges : bad)
+    {
+        fstream file(filename.c_str(), ios::in | ios::out | ios::binary);
+        file.seekp(rangesAt);
+        file.write(reinterpret_cast<const char*>(ranges.data()),
+                   ranges.size() * sizeof(uint64_t));
+        file.close();
+        PartialEquity loaded;
+        EXPECT_FALSE(loaded.load(filename));
+    }
+    remove(filename.c_str());
+}
+
+TEST(PartialEquity, LoadRejectsBadSizes)
+{
+    PartialEquity part(1, 1000, 2, false);
+    ASSERT_TRUE(part.cover(100, 200));
+    part.setLabels(vector<string>{"AA", "KK"});
+    string filename = ::testing::TempDir() + "sizes.pspe";
+
+    // the player count follows the magic, version, fingerprint and
+    // total, the first label length follows the exact flag, the range
+    // count and the one range
+    const streamoff playersAt = 4 + 4 + 8 + 8;
+    const streamoff labelAt = playersAt + 4 + 4 + 4 + 16;
+    const vector<pair<streamoff, uint32_t>> bad = {
+        {playersAt, 0},
+        {playersAt, 0xFFFFFFFF},
+        {labelAt, 0xFFFFFFFF},
+        {labelAt, 1000},
+    };
+    for (const pair<streamoff, uint32_t>& b : bad)
+    {
+        ASSERT_TRUE(part.save(filename));
+        {
+            fstream file(filename.c_str(), ios::in | ios::out | ios::binary);
+            file.seekp(b.first);
+            file.write(reinterpret_cast<const char*>(&b.second), sizeof(b.second));
+        }
+        PartialEquity loaded;
+        EXPECT_FALSE(loaded.load(filename));
+    }
+
+    ASSERT_TRUE(part.save(filename));
+    PartialEquity loaded;
+    EXPECT_TRUE(loaded.load(filename));
+    EXPECT_EQ(part.labels(), loaded.labels());
+    remove(filename.c_str());
+}
@@ -0,0 +1,119 @@
+/**
+ * Copyright (c) 2012 Andrew Prock. All rights reserved.
+ */
+#include "PreflopClasses.h"
+
+#include <pokerstove/peval/Card.h>
+#include <pokerstove/peval/Rank.h>
+#include <pokerstove/peval/Suit.h>
+
+using namespace std;
+
+namespace pokerstove
+{
+
+// exact all-in equity against a random hand, best to worst.
+// AA is 85.2%, 32o is 32.3%.
+static const char* kPreflopOrder[NUM_PREFLOP_CLASSES] = {
+    "AA",  "KK",  "QQ",  "JJ",  "TT",  "99",  "88",  "AKs", "77",  "AQs",
+    "AJs", "AKo", "ATs", "AQo", "AJo", "KQs", "66",  "A9s", "ATo", "KJs",
+    "A8s", "KTs", "KQo", "A7s", "A9o", "KJo", "55",  "QJs", "K9s", "A5s",
+    "A6s", "A8o", "KTo", "QTs", "A4s", "A7o", "K8s", "A3s", "QJo", "K9o",
+    "A5o", "A6o", "Q9s", "K7s", "JTs", "A2s", "QTo", "44",  "A4o", "K6s",
+    "K8o", "Q8s", "A3o", "K5s", "J9s", "Q9o", "JTo", "K7o", "A2o", "K4s",
+    "Q7s", "K6o", "K3s", "T9s", "J8s", "33",  "Q6s", "Q8o", "K5o", "J9o",
+    "K2s", "Q5s", "T8s", "K4o", "J7s", "Q4s", "Q7o", "T9o", "J8o", "K3o",
+    "Q6o", "Q3s", "98s", "T7s", "J6s", "K2o", "22",  "Q2s", "Q5o", "J5s",
+    "T8o", "J7o", "Q4o", "97s", "J4s", "T6s", "J3s", "Q3o", "98o", "87s",
+    "T7o", "J6o", "96s", "J2s", "Q2o", "T5s", "J5o", "T4s", "97o", "86s",
+    "J4o", "T6o", "95s", "T3s", "76s", "J3o", "87o", "T2s", "85s", "96o",
+    "J2o", "T5o", "94s", "75s", "T4o", "93s", "86o", "65s", "84s", "95o",
+    "T3o", "92s", "76o", "74s", "T2o", "54s", "85o", "64s", "83s", "94o",
+    "75o", "82s", "73s", "93o", "65o", "53s", "63s", "84o", "92o", "43s",
+    "74o", "72s", "54o", "64o", "52s", "62s", "83o", "42s", "82o", "73o",
+    "53o", "63o", "32s", "43o", "72o", "52o", "62o", "42o", "32o",
+};
+
+static size_t classIndex(int r1, int r2, bool suited)
+{
+    int hi = max(r1, r2);
+    int lo = min(r1, r2);
+    if (hi == lo || suited)
+        return hi * Rank::NUM_RANK + lo;
+    return lo * Rank::NUM_RANK + hi;
+}
+
+size_t preflopClass(const CardSet& hand)
+{
+    if (hand.size() != 2)
+        return NUM_PREFLOP_CLASSES;
+    vector<Card> cards = hand.cards();
+    return classIndex(cards[0].rank().code(), cards[1].rank().code(),
+                      cards[0].suit() == cards[1].suit());
+}
+
+string preflopClassName(size_t cls)
+{
+    if (cls >= NUM_PREFLOP_CLASSES)
+        return "";
+    int row = static_cast<int>(cls / Rank::NUM_RANK);
+    int col = static_cast<int>(cls % Rank::NUM_RANK);
+    string ret = Rank(static_cast<uint8_t>(max(row, col))).str() +
+                 Rank(static_cast<uint8_t>(min(row, col))).str();
+    if (row > col)
+        ret += "s";
+    else if (row < col)
+        ret += "o";
+    return ret;
+}
+
+size_t preflopClassFromName(const string& name)
+{
+    if (name.size() < 2 || name.size() > 3)
+        return NUM_PREFLOP_CLASSES;
+    int r1 = Rank::rank_code(name[0]);
+    int r2 = Rank::rank_code(name[1]);
+    if (r1 < 0 || r2 < 0)
+        return NUM_PREFLOP_CLASSES;
+    if (r1 == r2)
+        return (name.size() == 2) ? classIndex(r1, r2, false)
+                                  : NUM_PREFLOP_CLASSES;
+    if (name.size() != 3)
+        return NUM_PREFLOP_CLASSES;
+    char q = static_cast<char>(tolower(name[2]));
+    if (q != 's' && q != 'o')
+        return NUM_PREFLOP_CLASSES;
+    return classIndex(r1, r2, q == 's');
+}
+
+const vector<CardSet>& preflopClassHands(size_t cls)
+{
+    static const vector<vector<CardSet>> kClassHands = []() {
+        vector<vector<CardSet>> hands(NUM_PREFLOP_CLASSES);
+        for (uint8_t i = 0; i < STANDARD_DECK_SIZE; i++)
+            for (uint8_t j = i + 1; j < STANDARD_DECK_SIZE; j++)
+            {
+                CardSet hand((Card(i)));
+                hand.insert(Card(j));
+                hands[preflopClass(hand)].push_back(hand);
+            }
+        return hands;
+    }();
+    static const vector<CardSet> kEmpty;
+    if (cls >= NUM_PREFLOP_CLASSES)
+        return kEmpty;
+    return kClassHands[cls];
+}
+
+const vector<size_t>& preflopClassOrdering()
+{
+    static const vector<size_t> kOrdering = []() {
+        vector<size_t> order;
+        for (size_t i = 0; i < NUM_PREFLOP_CLASSES; i++)
+            order.push_back(preflopClassFromName(kPreflopOrder[i]));
+        return order;
+    }();
+    return kOrdering;
+}
+
+}  // namespace pokerstove
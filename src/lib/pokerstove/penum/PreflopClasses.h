@@ -0,0 +1,58 @@
+/**
+ * Copyright (c) 2012 Andrew Prock. All rights reserved.
+ */
+#ifndef PENUM_PREFLOPCLASSES_H_
+#define PENUM_PREFLOPCLASSES_H_
+
+#include <string>
+#include <vector>
+#include <pokerstove/peval/CardSet.h>
+
+namespace pokerstove
+{
+/**
+ * The 169 preflop hold'em hand classes.  Classes are indexed the same
+ * way as the usual 13x13 hand grid: pairs on the diagonal, suited hands
+ * above it, and offsuit hands below it.
+ *
+ *   index(AA)  = A*13 + A
+ *   index(AKs) = A*13 + K
+ *   index(AKo) = K*13 + A
+ *
+ * where the ranks are the Rank codes [0,12].
+ */
+const size_t NUM_PREFLOP_CLASSES = 169;
+
+/**
+ * return the class index of a two card hand, or NUM_PREFLOP_CLASSES if
+ * the hand does not have exactly two cards.
+ */
+size_t preflopClass(const CardSet& hand);
+
+/**
+ * return the name of a class, "AA", "AKs", "AKo", etc.
+ */
+std::string preflopClassName(size_t cls);
+
+/**
+ * parse a class name, returns NUM_PREFLOP_CLASSES on failure.  The
+ * suitedness qualifier is required for non-pairs.
+ */
+size_t preflopClassFromName(const std::string& name);
+
+/**
+ * All of the hands in a class: 6 for pairs, 4 for suited hands, and 12
+ * for offsuit hands.  These tables are built once, on first use.
+ */
+const std::vector<CardSet>& preflopClassHands(size_t cls);
+
+/**
+ * The classes ordered from best to worst by all-in equity against a
+ * random hand.  The ordering was computed by exact enumeration over all
+ * boards, and is used to expand "top N%" ranges.
+ */
+const std::vector<size_t>& preflopClassOrdering();
+
+}  // namespace pokerstove
+
+#endif  // PENUM_PREFLOPCLASSES_H_
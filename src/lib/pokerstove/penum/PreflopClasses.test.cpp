@@ -0,0 +1,43 @@
+#include "PreflopClasses.h"
+#include <gtest/gtest.h>
+#include <set>
+
+using namespace pokerstove;
+using namespace std;
+
+TEST(PreflopClasses, Names)
+{
+    EXPECT_EQ("AA", preflopClassName(preflopClass(CardSet("AcAd"))));
+    EXPECT_EQ("AKs", preflopClassName(preflopClass(CardSet("AhKh"))));
+    EXPECT_EQ("AKo", preflopClassName(preflopClass(CardSet("KhAs"))));
+    EXPECT_EQ("72o", preflopClassName(preflopClass(CardSet("7c2d"))));
+    EXPECT_EQ(NUM_PREFLOP_CLASSES, preflopClass(CardSet("AcKcQc")));
+
+    for (size_t i = 0; i < NUM_PREFLOP_CLASSES; i++)
+        EXPECT_EQ(i, preflopClassFromName(preflopClassName(i)));
+    EXPECT_EQ(NUM_PREFLOP_CLASSES, preflopClassFromName("AAs"));
+    EXPECT_EQ(NUM_PREFLOP_CLASSES, preflopClassFromName("AK"));
+}
+
+TEST(PreflopClasses, Hands)
+{
+    size_t total = 0;
+    for (size_t i = 0; i < NUM_PREFLOP_CLASSES; i++)
+    {
+        for (const CardSet& hand : preflopClassHands(i))
+            EXPECT_EQ(i, preflopClass(hand));
+        total += preflopClassHands(i).size();
+    }
+    EXPECT_EQ(1326, total);
+    EXPECT_EQ(6, preflopClassHands(preflopClassFromName("QQ")).size());
+    EXPECT_EQ(4, preflopClassHands(preflopClassFromName("QJs")).size());
+    EXPECT_EQ(12, preflopClassHands(preflopClassFromName("QJo")).size());
+}
+
+TEST(PreflopClasses, Ordering)
+{
+    const vector<size_t>& order = preflopClassOrdering();
+    EXPECT_EQ(NUM_PREFLOP_CLASSES, set<size_t>(order.begin(), order.end()).size());
+    EXPECT_EQ("AA", preflopClassName(order.front()));
+    EXPECT_EQ("32o", preflopClassName(order.back()));
+}
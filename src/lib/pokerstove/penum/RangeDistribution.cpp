@@ -0,0 +1,379 @@
+/**
+ * Copyright (c) 2012 Andrew Prock. All rights reserved.
+ */
+#include "RangeDistribution.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <vector>
+#include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
+#include <pokerstove/peval/Card.h>
+#include <pokerstove/util/combinations.h>
+#include "PreflopClasses.h"
+
+using namespace std;
+
+namespace pokerstove
+{
+
+namespace
+{
+const int NUM_HOLDEM_CLASS_COMBOS = 1326;
+
+bool isWild(char c) { return c == 'x' || c == 'X' || c == '*'; }
+
+bool isRankChar(char c) { return Rank::rank_code(c) >= 0; }
+
+bool isSuitChar(char c) { return c != 0 && strchr("cdhsCDHS", c) != NULL; }
+
+// a single hold'em class token like "AK", "AKs", or "TT"
+struct ClassSpec
+{
+    int hi;
+    int lo;
+    char suited;  // 's', 'o', or 0 for both
+
+    bool parse(const string& s)
+    {
+        if (s.size() < 2 || s.size() > 3)
+            return false;
+        int r1 = Rank::rank_code(s[0]);
+        int r2 = Rank::rank_code(s[1]);
+        if (r1 < 0 || r2 < 0)
+            return false;
+        hi = max(r1, r2);
+        lo = min(r1, r2);
+        suited = 0;
+        if (s.size() == 3)
+        {
+            suited = static_cast<char>(tolower(s[2]));
+            if ((suited != 's' && suited != 'o') || hi == lo)
+                return false;
+        }
+        return true;
+    }
+
+    bool pair() const { return hi == lo; }
+};
+
+// sorted suit counts, used to match suit qualifiers
+vector<int> suitProfile(const CardSet& hand)
+{
+    vector<int> profile;
+    for (Suit s = Suit::begin(); s < Suit::end(); ++s)
+    {
+        int n = static_cast<int>(hand.count(s));
+        if (n > 0)
+            profile.push_back(n);
+    }
+    sort(profile.rbegin(), profile.rend());
+    return profile;
+}
+
+}  // namespace
+
+RangeDistribution::RangeDistribution(size_t handSize)
+    : CardDistribution()
+    , _handSize(handSize)
+    , _ordering()
+{}
+
+bool RangeDistribution::parse(const string& input)
+{
+    if (input == ".")
+        return CardDistribution::parse(input);
+
+    clear();
+    vector<string> exprs;
+    boost::split(exprs, input, boost::is_any_of(","));
+    for (string expr : exprs)
+    {
+        boost::trim(expr);
+        if (expr.empty())
+            continue;
+
+        double weight = 1.0;
+        string::size_type weightPos = expr.rfind("=");
+        if (weightPos != string::npos)
+        {
+            try
+            {
+                weight = boost::lexical_cast<double>(
+                    boost::trim_copy(expr.substr(weightPos + 1)));
+            }
+            catch (boost::bad_lexical_cast&)
+            {
+                return false;
+            }
+            expr = boost::trim_copy(expr.substr(0, weightPos));
+        }
+        if (!parseExpression(expr, weight))
+            return false;
+    }
+    return size() > 0;
+}
+
+bool RangeDistribution::parseExpression(const string& expr, double weight)
+{
+    if (expr.empty())
+        return false;
+
+    // explicit cards alternate rank and suit characters, "AcKd"
+    bool cards = (expr.size() % 2 == 0);
+    for (size_t i = 0; cards && i < expr.size(); i += 2)
+        cards = isRankChar(expr[i]) && isSuitChar(expr[i + 1]);
+    if (cards)
+        return parseCards(expr, weight);
+
+    if (expr.find('%') != string::npos)
+        return parsePercent(expr, weight);
+
+    bool wild = any_of(expr.begin(), expr.end(), isWild);
+    if (_handSize == 2 && !wild)
+        return parseClasses(expr, weight);
+    return parsePattern(expr, weight);
+}
+
+bool RangeDistribution::parseCards(const string& expr, double weight)
+{
+    CardSet hand;
+    for (size_t i = 0; i < expr.size(); i += 2)
+    {
+        Card c;
+        if (!c.fromString(expr.substr(i, 2)) || hand.contains(c))
+            return false;
+        hand.insert(c);
+    }
+    if (hand.size() > _handSize)
+        return false;
+    insert(hand, weight);
+    return true;
+}
+
+bool RangeDistribution::parsePercent(const string& expr, double weight)
+{
+    bool useOrdering = _ordering && _ordering->handSize() == _handSize;
+
+    // the only ordering we carry with the library is the hold'em one
+    if (_handSize != 2 && !useOrdering)
+        return false;
+
+    vector<string> bounds;
+    boost::split(bounds, expr, boost::is_any_of("-"));
+    if (bounds.size() > 2)
+        return false;
+
+    vector<double> pcts;
+    for (const string& b : bounds)
+    {
+        if (b.size() < 2 || b.back() != '%')
+            return false;
+        try
+        {
+            pcts.push_back(boost::lexical_cast<double>(b.substr(0, b.size() - 1)));
+        }
+        catch (boost::bad_lexical_cast&)
+        {
+            return false;
+        }
+    }
+    double low = (pcts.size() == 2) ? min(pcts[0], pcts[1]) : 0.0;
+    double high = (pcts.size() == 2) ? max(pcts[0], pcts[1]) : pcts[0];
+    if (low < 0.0 || high > 100.0)
+        return false;
+
+    if (useOrdering)
+    {
+        CardDistribution hands = _ordering->range(low, high, weight);
+        for (size_t i = 0; i < hands.size(); i++)
+            insert(hands[i], weight);
+        return true;
+    }
+
+    // a class is included if the range has not yet been filled when it
+    // is reached, so a range always covers at least the requested share
+    double lowCombos = low / 100.0 * NUM_HOLDEM_CLASS_COMBOS;
+    double highCombos = high / 100.0 * NUM_HOLDEM_CLASS_COMBOS;
+    size_t combos = 0;
+    for (size_t cls : preflopClassOrdering())
+    {
+        if (combos >= highCombos)
+            break;
+        const vector<CardSet>& hands = preflopClassHands(cls);
+        if (combos >= lowCombos)
+            for (const CardSet& hand : hands)
+                insert(hand, weight);
+        combos += hands.size();
+    }
+    return true;
+}
+
+bool RangeDistribution::parseClasses(const string& expr, double weight)
+{
+    vector<ClassSpec> classes;
+    auto add = [&](int hi, int lo, char suited) {
+        ClassSpec spec = {hi, lo, suited};
+        classes.push_back(spec);
+    };
+
+    string::size_type dash = expr.find('-');
+    if (dash != string::npos)
+    {
+        ClassSpec a, b;
+        if (!a.parse(expr.substr(0, dash)) || !b.parse(expr.substr(dash + 1)))
+            return false;
+        if (a.suited != b.suited || a.pair() != b.pair())
+            return false;
+        if (a.pair())
+        {
+            for (int r = min(a.hi, b.hi); r <= max(a.hi, b.hi); r++)
+                add(r, r, 0);
+        }
+        else if (a.hi == b.hi)
+        {
+            for (int r = min(a.lo, b.lo); r <= max(a.lo, b.lo); r++)
+                add(a.hi, r, a.suited);
+        }
+        else if (a.hi - a.lo == b.hi - b.lo)
+        {
+            int gap = a.hi - a.lo;
+            for (int r = min(a.hi, b.hi); r <= max(a.hi, b.hi); r++)
+                add(r, r - gap, a.suited);
+        }
+        else
+        {
+            return false;
+        }
+    }
+    else if (expr.back() == '+')
+    {
+        ClassSpec a;
+        if (!a.parse(expr.substr(0, expr.size() - 1)))
+            return false;
+        if (a.pair())
+            for (int r = a.hi; r < static_cast<int>(Rank::NUM_RANK); r++)
+                add(r, r, 0);
+        else
+            for (int r = a.lo; r < a.hi; r++)
+                add(a.hi, r, a.suited);
+    }
+    else
+    {
+        ClassSpec a;
+        if (!a.parse(expr))
+            return false;
+        classes.push_back(a);
+    }
+
+    for (const ClassSpec& spec : classes)
+    {
+        string name = Rank(static_cast<uint8_t>(spec.hi)).str() +
+                      Rank(static_cast<uint8_t>(spec.lo)).str();
+        vector<string> names;
+        if (spec.pair())
+            names.push_back(name);
+        else if (spec.suited)
+            names.push_back(name + spec.suited);
+        else
+        {
+            names.push_back(name + "s");
+            names.push_back(name + "o");
+        }
+        for (const string& n : names)
+            for (const CardSet& hand : preflopClassHands(preflopClassFromName(n)))
+                insert(hand, weight);
+    }
+    return true;
+}
+
+bool RangeDistribution::parsePattern(const string& expr, double weight)
+{
+    if (expr.size() < _handSize)
+        return false;
+
+    // rank part, fixed ranks are counted, wildcards are dealt from
+    // whatever is left in the deck
+    vector<int> rankCount(Rank::NUM_RANK, 0);
+    size_t nwild = 0;
+    for (size_t i = 0; i < _handSize; i++)
+    {
+        if (isWild(expr[i]))
+        {
+            nwild++;
+            continue;
+        }
+        int r = Rank::rank_code(expr[i]);
+        if (r < 0 || ++rankCount[r] > static_cast<int>(Suit::NUM_SUIT))
+            return false;
+    }
+
+    // suit qualifier, expressed as the sorted suit counts of the hand
+    string qualifier = boost::to_lower_copy(expr.substr(_handSize));
+    vector<int> profile;
+    if (qualifier == "s" && _handSize == 2)
+        profile = {2};
+    else if (qualifier == "o" && _handSize == 2)
+        profile = {1, 1};
+    else if (qualifier == "ds" && _handSize == 4)
+        profile = {2, 2};
+    else if (qualifier == "ss" && _handSize == 4)
+        profile = {2, 1, 1};
+    else if (qualifier == "r" && _handSize <= Suit::NUM_SUIT)
+        profile.assign(_handSize, 1);
+    else if (!qualifier.empty())
+        return false;
+
+    // all the ways to pick suits for the fixed ranks
+    vector<CardSet> fixed(1, CardSet());
+    for (int r = 0; r < static_cast<int>(Rank::NUM_RANK); r++)
+    {
+        if (rankCount[r] == 0)
+            continue;
+        vector<CardSet> next;
+        combinations suits(Suit::NUM_SUIT, rankCount[r]);
+        do
+        {
+            CardSet cards;
+            for (int i = 0; i < rankCount[r]; i++)
+                cards.insert(Card(Rank(static_cast<uint8_t>(r)),
+                                  Suit(static_cast<uint8_t>(suits[i]))));
+            for (const CardSet& f : fixed)
+                next.push_back(f | cards);
+        } while (suits.next());
+        fixed.swap(next);
+    }
+
+    // fill in the wildcards, different fixed picks can produce the same
+    // hand when a wildcard matches a fixed rank, so we dedupe
+    vector<CardSet> hands;
+    for (const CardSet& f : fixed)
+    {
+        if (nwild == 0)
+        {
+            hands.push_back(f);
+            continue;
+        }
+        CardSet deck;
+        deck.fill();
+        vector<Card> live = CardSet(deck ^ f).cards();
+        combinations wild(live.size(), nwild);
+        do
+        {
+            CardSet hand = f;
+            for (size_t i = 0; i < nwild; i++)
+                hand.insert(live[wild[i]]);
+            hands.push_back(hand);
+        } while (wild.next());
+    }
+    sort(hands.begin(), hands.end());
+    hands.erase(unique(hands.begin(), hands.end()), hands.end());
+
+    for (const CardSet& hand : hands)
+        if (profile.empty() || suitProfile(hand) == profile)
+            insert(hand, weight);
+    return true;
+}
+
+}  // namespace pokerstove
@@ -0,0 +1,71 @@
+/**
+ * Copyright (c) 2012 Andrew Prock. All rights reserved.
+ */
+#ifndef PENUM_RANGEDISTRIBUTION_H_
+#define PENUM_RANGEDISTRIBUTION_H_
+
+#include <memory>
+#include <string>
+#include "CardDistribution.h"
+#include "HandOrdering.h"
+
+namespace pokerstove
+{
+/**
+ * A card distribution which understands the usual range notation.  The
+ * input is a comma separated list of range expressions, each of which
+ * may carry a weight with the same "=weight" syntax as the raw
+ * CardDistribution.
+ *
+ * hold'em (hand size 2):
+ * - AA, AKs, AKo, AK        single classes, AK is both suited and offsuit
+ * - QQ+, ATs+, ATo+         pairs up to aces, kickers up to one below
+ * - 22-66, A2s-A5s, 76s-54s spans of pairs, kickers, or connectors
+ * - Ax, Kxs                 'x' (or '*') matches any rank
+ * - 15%, 10%-20%            top hands by equity against a random hand
+ *
+ * omaha (hand size 4):
+ * - AAxx, AKQJ, KKxx        ranks with wildcards
+ * - AAxxds, AKQJss, JT98r   double suited, single suited, rainbow
+ *
+ * For any hand size explicit cards such as "AcKd" or "AcKd=0.5" are
+ * accepted, as are partial hands for games which deal the rest.
+ *
+ * Percentages use the built in hold'em ordering unless a HandOrdering
+ * with a matching hand size has been set, which is how omaha and other
+ * games get "top N%" ranges.
+ *
+ * Hands which appear in more than one expression take the weight of the
+ * last one.
+ */
+class RangeDistribution : public CardDistribution
+{
+public:
+    explicit RangeDistribution(size_t handSize = 2);
+
+    virtual bool parse(const std::string& input);
+
+    size_t handSize() const { return _handSize; }
+
+    /**
+     * use a precomputed ordering for percentage expressions
+     */
+    void setOrdering(std::shared_ptr<const HandOrdering> ordering)
+    {
+        _ordering = ordering;
+    }
+
+private:
+    bool parseExpression(const std::string& expr, double weight);
+    bool parseCards(const std::string& expr, double weight);
+    bool parsePercent(const std::string& expr, double weight);
+    bool parseClasses(const std::string& expr, double weight);
+    bool parsePattern(const std::string& expr, double weight);
+
+    size_t _handSize;
+    std::shared_ptr<const HandOrdering> _ordering;
+};
+
+}  // namespace pokerstove
+
+#endif  // PENUM_RANGEDISTRIBUTION_H_
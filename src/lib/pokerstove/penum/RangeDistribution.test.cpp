@@ -0,0 +1,116 @@
+#include "RangeDistribution.h"
+#include <gtest/gtest.h>
+
+using namespace pokerstove;
+using namespace std;
+
+TEST(RangeDistribution, HoldemClasses)
+{
+    RangeDistribution dist;
+    EXPECT_TRUE(dist.parse("AA"));
+    EXPECT_EQ(6, dist.size());
+    EXPECT_TRUE(dist.parse("AKs"));
+    EXPECT_EQ(4, dist.size());
+    EXPECT_TRUE(dist.parse("AKo"));
+    EXPECT_EQ(12, dist.size());
+    EXPECT_TRUE(dist.parse("AK"));
+    EXPECT_EQ(16, dist.size());
+    EXPECT_FALSE(dist.parse("AAs"));
+    EXPECT_FALSE(dist.parse("AZ"));
+}
+
+TEST(RangeDistribution, HoldemPlusAndSpans)
+{
+    RangeDistribution dist;
+    EXPECT_TRUE(dist.parse("QQ+"));
+    EXPECT_EQ(18, dist.size());
+    EXPECT_TRUE(dist.parse("ATo+"));
+    EXPECT_EQ(4 * 12, dist.size());
+    EXPECT_TRUE(dist.parse("22-44"));
+    EXPECT_EQ(18, dist.size());
+    EXPECT_TRUE(dist.parse("76s-54s"));
+    EXPECT_EQ(12, dist.size());
+    EXPECT_GT(dist[CardSet("6h5h")], 0.0);
+    EXPECT_EQ(0.0, dist[CardSet("6h4h")]);
+    EXPECT_TRUE(dist.parse("A2s-A5s"));
+    EXPECT_EQ(16, dist.size());
+    EXPECT_FALSE(dist.parse("A2s-K5s"));
+}
+
+TEST(RangeDistribution, HoldemListAndWeights)
+{
+    RangeDistribution dist;
+    EXPECT_TRUE(dist.parse("QQ+, AKs, ATo+, 76s-54s"));
+    EXPECT_EQ(18 + 4 + 48 + 12, dist.size());
+
+    // later expressions override the weight, hands are not duplicated
+    EXPECT_TRUE(dist.parse("QQ+=0.5, AA"));
+    EXPECT_EQ(18, dist.size());
+    EXPECT_EQ(1.0, dist[CardSet("AcAd")]);
+    EXPECT_EQ(0.5, dist[CardSet("KcKd")]);
+    EXPECT_DOUBLE_EQ(12 * 0.5 + 6, dist.weight());
+
+    EXPECT_TRUE(dist.parse("AcKd=0.25,AsKs"));
+    EXPECT_EQ(2, dist.size());
+    EXPECT_EQ(0.25, dist[CardSet("AcKd")]);
+    EXPECT_FALSE(dist.parse("AcKd="));
+}
+
+TEST(RangeDistribution, HoldemWildcards)
+{
+    RangeDistribution dist;
+    EXPECT_TRUE(dist.parse("Ax"));
+    EXPECT_EQ(6 + 12 * 16, dist.size());
+    EXPECT_TRUE(dist.parse("Axs"));
+    EXPECT_EQ(12 * 4, dist.size());
+}
+
+TEST(RangeDistribution, HoldemPercent)
+{
+    RangeDistribution dist;
+    EXPECT_TRUE(dist.parse("100%"));
+    EXPECT_EQ(1326, dist.size());
+
+    // top classes are AA, KK, QQ, ...
+    EXPECT_TRUE(dist.parse("1%"));
+    EXPECT_EQ(18, dist.size());
+    EXPECT_TRUE(dist.parse("15%"));
+    EXPECT_GE(dist.size(), 0.15 * 1326);
+    EXPECT_LT(dist.size(), 0.15 * 1326 + 12);
+
+    RangeDistribution top10, top20, slice;
+    EXPECT_TRUE(top10.parse("10%"));
+    EXPECT_TRUE(top20.parse("20%"));
+    EXPECT_TRUE(slice.parse("10%-20%"));
+    EXPECT_EQ(top20.size(), top10.size() + slice.size());
+    EXPECT_EQ(0.0, slice[CardSet("AcAd")]);
+}
+
+TEST(RangeDistribution, Omaha)
+{
+    RangeDistribution dist(4);
+    EXPECT_TRUE(dist.parse("AAKK"));
+    EXPECT_EQ(36, dist.size());
+    EXPECT_TRUE(dist.parse("AAKKds"));
+    EXPECT_EQ(6, dist.size());
+    EXPECT_TRUE(dist.parse("AKQJr"));
+    EXPECT_EQ(24, dist.size());
+    EXPECT_TRUE(dist.parse("AAxx"));
+    // exactly two, three, or four aces
+    EXPECT_EQ(6 * 1128 + 4 * 48 + 1, dist.size());
+    EXPECT_TRUE(dist.parse("AcAdKsQh"));
+    EXPECT_EQ(1, dist.size());
+    EXPECT_FALSE(dist.parse("AAK"));
+    EXPECT_FALSE(dist.parse("15%"));
+}
+
+TEST(RangeDistribution, PartialHands)
+{
+    // stud hands with some of the cards known
+    RangeDistribution dist(7);
+    EXPECT_TRUE(dist.parse("AcAdKs"));
+    EXPECT_EQ(1, dist.size());
+    EXPECT_EQ(3, dist[0].size());
+    EXPECT_TRUE(dist.parse("."));
+    EXPECT_EQ(1, dist.size());
+}
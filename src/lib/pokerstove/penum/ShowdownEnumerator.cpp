@@ -3,12 +3,24 @@
  */
 #include "ShowdownEnumerator.h"
 
+#include <algorithm>
+#include <cmath>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
-#include "Odometer.h"
+#include "EnumerationCheckpoint.h"
+#include "EnumerationMonitor.h"
+#include "EnumerationStats.h"
+#include "DisjointOdometer.h"
 #include "PartitionEnumerator.h"
 #include "SimpleDeck.hpp"
+#include <pokerstove/peval/PokerHandEvaluation.h>
+#include <pokerstove/util/combinations.h>
+
+#ifdef POKERSTOVE_STATS
+#include <pokerstove/util/timing.hpp>
+#endif
 
 using std::runtime_error;
 using std::string;
@@ -17,18 +29,420 @@ using std::vector;
 namespace pokerstove
 {
 
+namespace
+{
+// how many showdowns are evaluated between progress updates
+const uint64_t kPublishInterval = 1 << 16;
+
+// the number of ways to deal the partitions from a deck
+double countPartitions(size_t deckSize, const vector<size_t>& parts)
+{
+    double count = 1.0;
+    int remaining = static_cast<int>(deckSize);
+    for (size_t p : parts)
+    {
+        count *= choose(remaining, static_cast<int>(p));
+        remaining -= static_cast<int>(p);
+    }
+    return count;
+}
+
+// the same count in integers, saturating at kAllShowdowns
+uint64_t countDeals(size_t deckSize, const vector<size_t>& parts)
+{
+    uint64_t count = 1;
+    size_t remaining = deckSize;
+    for (size_t p : parts)
+    {
+        // n choose k, each partial product is itself a binomial
+        uint64_t c = 1;
+        for (size_t i = 1; i <= p; i++)
+        {
+            uint64_t n = remaining - p + i;
+            if (c > ShowdownEnumerator::ALL_SHOWDOWNS / n)
+                return ShowdownEnumerator::ALL_SHOWDOWNS;
+            c = c * n / i;
+        }
+        if (c != 0 && count > ShowdownEnumerator::ALL_SHOWDOWNS / c)
+            return ShowdownEnumerator::ALL_SHOWDOWNS;
+        count *= c;
+        remaining -= p;
+    }
+    return count;
+}
+
+// hand weights multiply into exact shares, so they have to be whole
+void checkExact(const vector<CardDistribution>& dists)
+{
+    if (dists.size() > ShowdownTally::MAX_EXACT)
+        throw runtime_error("ShowdownEnumerator, too many players for exact equity");
+    for (const CardDistribution& dist : dists)
+        for (size_t i = 0; i < dist.size(); i++)
+        {
+            double w = dist[dist[i]];
+            if (w < 0.0 || w != floor(w))
+                throw runtime_error("ShowdownEnumerator, exact equity needs integer weights");
+        }
+}
+
+// the progress of a run which continues base and has covered [begin,next)
+PartialEquity snapshot(const PartialEquity& base,
+                       uint64_t begin,
+                       uint64_t next,
+                       const vector<EquityResult>& results,
+                       const vector<ExactEquityResult>* exact)
+{
+    PartialEquity piece(base.fingerprint(), base.total(), base.size(), base.exact());
+    piece.results() = results;
+    if (exact)
+        piece.exactResults() = *exact;
+    piece.cover(begin, next);
+    PartialEquity ret = base;
+    ret.merge(piece);
+    return ret;
+}
+
+// the share of all the showdowns a partial result covers
+double coveredFraction(const PartialEquity& part)
+{
+    return static_cast<double>(part.covered()) / std::max<uint64_t>(part.total(), 1);
+}
+
+#ifdef POKERSTOVE_STATS
+void countShowdown(EnumerationStats& counts, int flags)
+{
+    counts.showdowns++;
+    if (flags & PokerHandEvaluator::SHOWDOWN_TIE)
+        counts.ties++;
+    if (flags & PokerHandEvaluator::SHOWDOWN_SPLIT)
+        counts.splitPots++;
+}
+
+void finishStats(EnumerationStats& counts,
+                 const boost::timer::cpu_timer& timer,
+                 EnumerationStats* stats)
+{
+    counts.wallSeconds = elapsed(timer);
+    counts.cpuSeconds = elapsedCpu(timer);
+    if (stats)
+        *stats += counts;
+}
+#endif
+
+/**
+ * Range weight summed over every subset of the cards of each hand added,
+ * so that the weight of the hands which are disjoint from any set of
+ * cards can be found by inclusion-exclusion over its subsets.
+ */
+class RemovalSums
+{
+public:
+    void add(uint64_t mask, double weight)
+    {
+        uint64_t sub = mask;
+        while (true)
+        {
+            _sums[sub] += weight;
+            if (sub == 0)
+                break;
+            sub = (sub - 1) & mask;
+        }
+    }
+
+    double disjoint(uint64_t mask) const
+    {
+        double total = 0.0;
+        uint64_t sub = mask;
+        while (true)
+        {
+            std::unordered_map<uint64_t, double>::const_iterator it = _sums.find(sub);
+            if (it != _sums.end())
+                total += (CardSet(sub).size() % 2 == 0) ? it->second : -it->second;
+            if (sub == 0)
+                break;
+            sub = (sub - 1) & mask;
+        }
+        return total;
+    }
+
+    void clear() { _sums.clear(); }
+
+private:
+    std::unordered_map<uint64_t, double> _sums;
+};
+
+// the weight of the hands of a range which share no cards with the hand
+// or the board
+double disjointWeight(const CardSet& hand, const CardDistribution& range, const CardSet& board)
+{
+    double total = 0.0;
+    if (hand.intersects(board))
+        return total;
+    for (size_t i = 0; i < range.size(); i++)
+        if (range[i].disjoint(hand) && range[i].disjoint(board))
+            total += range[range[i]];
+    return total;
+}
+
+struct RankedHand
+{
+    int code;
+    uint64_t mask;
+    double weight;
+    size_t index;
+
+    bool operator<(const RankedHand& other) const { return code < other.code; }
+};
+
+vector<RankedHand> rankHands(const CardDistribution& dist,
+                             const CardSet& board,
+                             const PokerHandEvaluator& peval)
+{
+    vector<RankedHand> ranked;
+    ranked.reserve(dist.size());
+    for (size_t i = 0; i < dist.size(); i++)
+    {
+        const CardSet& hand = dist[i];
+        if (hand.intersects(board))
+            continue;
+        RankedHand r;
+        r.code = peval.evaluateHand(hand, board).high().code();
+        r.mask = hand.mask();
+        r.weight = dist[hand];
+        r.index = i;
+        ranked.push_back(r);
+    }
+    sort(ranked.begin(), ranked.end());
+    return ranked;
+}
+}  // namespace
+
 ShowdownEnumerator::ShowdownEnumerator() {}
 
 vector<EquityResult> ShowdownEnumerator::calculateEquity(const vector<CardDistribution>& dists,
                                                          const CardSet& board,
-                                                         std::shared_ptr<PokerHandEvaluator> peval) const
+                                                         std::shared_ptr<PokerHandEvaluator> peval,
+                                                         EnumerationMonitor* monitor,
+                                                         EnumerationStats* stats) const
+{
+    return equity(dists, board, peval, monitor, stats, NULL);
+}
+
+vector<EquityResult>
+ShowdownEnumerator::calculateComboEquity(const vector<CardDistribution>& dists,
+                                         const CardSet& board,
+                                         std::shared_ptr<PokerHandEvaluator> peval,
+                                         vector<ComboResult>& combos,
+                                         EnumerationMonitor* monitor,
+                                         EnumerationStats* stats) const
+{
+    combos.assign(comboOffsets(dists).back(), ComboResult());
+    return equity(dists, board, peval, monitor, stats, &combos);
+}
+
+vector<size_t> ShowdownEnumerator::comboOffsets(const vector<CardDistribution>& dists)
+{
+    vector<size_t> offsets(1, 0);
+    for (const CardDistribution& dist : dists)
+        offsets.push_back(offsets.back() + dist.size());
+    return offsets;
+}
+
+vector<EquityResult> ShowdownEnumerator::equity(const vector<CardDistribution>& dists,
+                                                const CardSet& board,
+                                                std::shared_ptr<PokerHandEvaluator> peval,
+                                                EnumerationMonitor* monitor,
+                                                EnumerationStats* stats,
+                                                vector<ComboResult>* combos) const
 {
     if (peval.get() == NULL)
         throw runtime_error("ShowdownEnumerator, null evaluator");
     assert(dists.size() > 1);
     const size_t ndists = dists.size();
     vector<EquityResult> results(ndists, EquityResult());
+
+    // heads up on a complete board only the rank of each hand matters
+    if (isShowdown(dists, board, *peval))
+    {
+        PENUM_STAT(boost::timer::cpu_timer timer);
+        PENUM_STAT(EnumerationStats counts);
+        for (size_t i = 0; i < ndists; i++)
+        {
+            const CardDistribution& hero = dists[i];
+            vector<EquityResult> vs =
+                calculateEquityVsRange(hero, dists[1 - i], board, peval);
+            for (size_t h = 0; h < hero.size(); h++)
+            {
+                double w = hero[hero[h]];
+                results[i].winShares += w * vs[h].winShares;
+                results[i].tieShares += w * vs[h].tieShares;
+                if (combos)
+                {
+                    // every opposing hand which does not collide is one pot
+                    ComboResult& combo = (*combos)[(i == 0) ? h : dists[0].size() + h];
+                    combo.winShares = w * vs[h].winShares;
+                    combo.tieShares = w * vs[h].tieShares;
+                    combo.pots = w * disjointWeight(hero[h], dists[1 - i], board);
+                }
+            }
+        }
+        if (monitor)
+            monitor->update(1.0, dists[0].size() + dists[1].size(), results);
+        PENUM_STAT(counts.evaluations[peval->id()] += 2 * (dists[0].size() + dists[1].size()));
+        PENUM_STAT(finishStats(counts, timer, stats));
+        return results;
+    }
+
+    enumerate(dists, board, *peval, monitor, stats, 0, ALL_SHOWDOWNS, results, NULL, NULL, NULL,
+              combos);
+    return results;
+}
+
+vector<ExactEquityResult>
+ShowdownEnumerator::calculateExactEquity(const vector<CardDistribution>& dists,
+                                         const CardSet& board,
+                                         std::shared_ptr<PokerHandEvaluator> peval,
+                                         EnumerationMonitor* monitor,
+                                         EnumerationStats* stats) const
+{
+    if (peval.get() == NULL)
+        throw runtime_error("ShowdownEnumerator, null evaluator");
+    assert(dists.size() > 1);
+    const size_t ndists = dists.size();
+    checkExact(dists);
+
+    vector<EquityResult> results(ndists, EquityResult());
+    vector<ExactEquityResult> exact(ndists);
+    enumerate(dists, board, *peval, monitor, stats, 0, ALL_SHOWDOWNS, results, &exact, NULL, NULL);
+    return exact;
+}
+
+uint64_t ShowdownEnumerator::countShowdowns(const vector<CardDistribution>& dists,
+                                            const CardSet& board,
+                                            std::shared_ptr<PokerHandEvaluator> peval) const
+{
+    if (peval.get() == NULL)
+        throw runtime_error("ShowdownEnumerator, null evaluator");
+
     size_t handsize = peval->handSize();
+    size_t boardsize = peval->boardSize();
+    CardSet deck = peval->deck();
+    vector<size_t> parts(dists.size() + (boardsize > 0 ? 1 : 0));
+    uint64_t total = 0;
+    DisjointOdometer o(dists, board);
+    for (bool more = o.valid(); more; more = o.next())
+    {
+        CardSet dead = board;
+        for (size_t i = 0; i < dists.size(); i++)
+        {
+            const CardSet& hand = dists[i][o[i]];
+            parts[i] = handsize - hand.size();
+            dead |= hand;
+        }
+        if (boardsize > 0)
+            parts.back() = boardsize - board.size();
+        uint64_t deals = countDeals(CardSet(deck ^ (deck & dead)).size(), parts);
+        if (deals == ALL_SHOWDOWNS || total > ALL_SHOWDOWNS - deals - 1)
+            throw runtime_error("ShowdownEnumerator, too many showdowns to count");
+        total += deals;
+    }
+    return total;
+}
+
+PartialEquity
+ShowdownEnumerator::calculatePartialEquity(const vector<CardDistribution>& dists,
+                                           const CardSet& board,
+                                           std::shared_ptr<PokerHandEvaluator> peval,
+                                           uint64_t begin,
+                                           uint64_t end,
+                                           bool exact,
+                                           EnumerationMonitor* monitor,
+                                           EnumerationCheckpoint* checkpoint,
+                                           EnumerationStats* stats) const
+{
+    if (peval.get() == NULL)
+        throw runtime_error("ShowdownEnumerator, null evaluator");
+    assert(dists.size() > 1);
+    if (exact)
+        checkExact(dists);
+
+    uint64_t total = countShowdowns(dists, board, peval);
+    end = std::min(end, total);
+    if (begin > end)
+        throw runtime_error("ShowdownEnumerator, empty work unit");
+
+    PartialEquity part(PartialEquity::fingerprint(dists, board, *peval),
+                       total, dists.size(), exact);
+    resumePartialEquity(part, dists, board, peval, begin, end, monitor, checkpoint,
+                        stats);
+    return part;
+}
+
+void ShowdownEnumerator::resumePartialEquity(PartialEquity& part,
+                                             const vector<CardDistribution>& dists,
+                                             const CardSet& board,
+                                             std::shared_ptr<PokerHandEvaluator> peval,
+                                             uint64_t begin,
+                                             uint64_t end,
+                                             EnumerationMonitor* monitor,
+                                             EnumerationCheckpoint* checkpoint,
+                                             EnumerationStats* stats) const
+{
+    if (peval.get() == NULL)
+        throw runtime_error("ShowdownEnumerator, null evaluator");
+    if (part.fingerprint() != PartialEquity::fingerprint(dists, board, *peval) ||
+        part.size() != dists.size())
+        throw runtime_error("ShowdownEnumerator, partial results are from a different enumeration");
+    if (part.exact())
+        checkExact(dists);
+
+    // the pieces of [begin,end) which are not covered yet
+    end = std::min(end, part.total());
+    vector<PartialEquity::Range> gaps;
+    uint64_t at = begin;
+    for (const PartialEquity::Range& r : part.ranges())
+    {
+        if (r.first > at && at < end)
+            gaps.push_back(PartialEquity::Range(at, std::min(r.first, end)));
+        at = std::max(at, r.second);
+    }
+    if (at < end)
+        gaps.push_back(PartialEquity::Range(at, end));
+
+    for (const PartialEquity::Range& gap : gaps)
+    {
+        PartialEquity piece(part.fingerprint(), part.total(), part.size(), part.exact());
+        uint64_t done = enumerate(dists, board, *peval, monitor, stats,
+                                  gap.first, gap.second, piece.results(),
+                                  part.exact() ? &piece.exactResults() : NULL,
+                                  checkpoint, &part);
+        piece.cover(gap.first, done);
+        part.merge(piece);
+        if (done < gap.second)
+            break;
+    }
+    if (checkpoint)
+        checkpoint->save(part);
+}
+
+uint64_t ShowdownEnumerator::enumerate(const vector<CardDistribution>& dists,
+                                       const CardSet& board,
+                                       const PokerHandEvaluator& peval,
+                                       EnumerationMonitor* monitor,
+                                       EnumerationStats* stats,
+                                       uint64_t begin,
+                                       uint64_t end,
+                                       vector<EquityResult>& results,
+                                       vector<ExactEquityResult>* exact,
+                                       EnumerationCheckpoint* checkpoint,
+                                       const PartialEquity* base,
+                                       vector<ComboResult>* combos) const
+{
+    const size_t ndists = dists.size();
+    size_t handsize = peval.handSize();
+    PENUM_STAT(boost::timer::cpu_timer timer);
+    PENUM_STAT(EnumerationStats counts);
+    (void)stats;
 
     // the dsizes vector is a list of the sizes of the player hand
     // distributions
@@ -42,30 +456,88 @@ vector<EquityResult> ShowdownEnumerator::calculateEquity(const vector<CardDistri
     // need to figure out the board stuff, we'll be rolling the board into
     // the partitions to make enumeration easier down the line.
     size_t nboards = 0;
-    size_t boardsize = peval->boardSize();
+    size_t boardsize = peval.boardSize();
     if (boardsize > 0)
         nboards++;
 
     // for the most part, these are allocated here to avoid contant stack
     // reallocation as we cycle through the inner loops
-    SimpleDeck deck;
+    SimpleDeck deck(peval.deck());
     CardSet dead;
     double weight;
     vector<CardSet>             ehands         (ndists + nboards);
     vector<size_t>              parts          (ndists + nboards);
     vector<CardSet>             cardPartitions (ndists + nboards);
-    vector<PokerHandEvaluation> evals          (ndists);  // NO BOARD
+    vector<int>                 high           (ndists);
+    vector<int>                 low            (ndists);
+
+    // showdowns are counted in integers and folded into the results once
+    // per hand combination, by way of the tuple's own results when the
+    // hands are broken out into combos
+    bool split = peval.evaluationSize() > 1;
+    ShowdownTally tally(ndists);
+    vector<EquityResult> tuple(ndists, EquityResult());
+    vector<size_t> offsets = comboOffsets(dists);
 
     // copy quickness
     CardSet* copydest = &ehands[0];
     CardSet* copysrc = &cardPartitions[0];
     size_t ncopy = (ndists + nboards) * sizeof(CardSet);
-    Odometer o(dsizes);
-    do
+
+    // progress is the position of the current tuple in the full index
+    // space, credited by the share of its partitions which have been
+    // dealt.  A slice continues base, and reports the share of all the
+    // showdowns which base and the slice have covered, with the results
+    // of both.
+    bool sliced = (begin > 0 || end != ALL_SHOWDOWNS);
+    if (sliced && base == NULL)
+        throw runtime_error("ShowdownEnumerator, a slice needs the partial results it continues");
+    double nsteps = 1.0;
+    for (size_t i = 0; i < ndists; i++)
+        nsteps *= dsizes[i];
+    double fraction = 0.0;
+    uint64_t nevals = 0;
+    uint64_t published = 0;
+    uint64_t index = 0;  // number of the first showdown of the tuple
+    uint64_t next = 0;   // number of the next showdown to evaluate
+    bool stopped = false;
+
+    // only tuples of hands which are disjoint from each other and from
+    // the board are visited, colliding combos are filtered out as each
+    // hand is picked rather than rejected once the tuple is complete
+    DisjointOdometer o(dists, board);
+
+    auto flush = [&]() {
+        if (exact)
+        {
+            tally.flush(*exact, static_cast<uint64_t>(weight));
+            for (size_t i = 0; i < ndists; i++)
+                results[i] = (*exact)[i].result();
+        }
+        else if (combos)
+        {
+            tally.flush(tuple, weight);
+            double pots = 0.0;
+            for (size_t i = 0; i < ndists; i++)
+                pots += tuple[i].winShares + tuple[i].tieShares;
+            for (size_t i = 0; i < ndists; i++)
+            {
+                ComboResult& combo = (*combos)[offsets[i] + o[i]];
+                combo.winShares += tuple[i].winShares;
+                combo.tieShares += tuple[i].tieShares;
+                combo.pots += pots;
+                results[i] += tuple[i];
+                tuple[i] = EquityResult();
+            }
+        }
+        else
+        {
+            tally.flush(results, weight);
+        }
+    };
+
+    for (bool more = o.valid(); more && !stopped; more = o.next())
     {
-        // colect all the cards being used by the players, skip out in the
-        // case of card duplication
-        bool disjoint = true;
         dead.clear();
         weight = 1.0;
         for (size_t i = 0; i < ndists + nboards; i++)
@@ -82,35 +554,249 @@ vector<EquityResult> ShowdownEnumerator::calculateEquity(const vector<CardDistri
                 cardPartitions[i] = board;
                 parts[i]          = boardsize - cardPartitions[i].size();
             }
-            disjoint = disjoint && dead.disjoint(cardPartitions[i]);
             dead |= cardPartitions[i];
         }
 
-        if (disjoint)
+        // whole tuples outside of the slice are skipped by their count
+        deck.reset();
+        deck.remove(dead);
+        uint64_t ndeals = countDeals(deck.size(), parts);
+        if (sliced && index >= end)
+            break;
+        if (sliced && ndeals <= begin - std::min(begin, index))
+        {
+            index += ndeals;
+            continue;
+        }
+        PENUM_STAT(counts.odometerSteps++);
+
+        PartitionEnumerator2 pe(deck.size(), parts);
+        for (next = index; next < begin; next++)
+        {
+            pe.next();
+            PENUM_STAT(counts.partitions++);
+        }
+        double npartitions = monitor ? countPartitions(deck.size(), parts) : 1.0;
+        double start = monitor ? o.fraction() : 0.0;
+        uint64_t first = nevals;
+        do
         {
-            deck.reset();
-            deck.remove(dead);
-            PartitionEnumerator2 pe(deck.size(), parts);
-            do
+            if (next >= end)
+                break;
+
+            // we use memcpy here for a little speed bonus
+            // NOTE: this could break subclass semantics
+            memcpy((void*)copydest, copysrc, ncopy);
+            for (size_t p = 0; p < ndists + nboards; p++)
+                ehands[p] |= deck.peek(pe.getMask(p));
+
+            // TODO: rework tracking of whether a board is needed
+            const CardSet& showdownBoard = (nboards > 0) ? ehands[ndists] : board;
+            int flags;
+            if (split)
+            {
+                for (size_t i = 0; i < ndists; i++)
+                {
+                    PokerHandEvaluation eval = peval.evaluateHand(ehands[i], showdownBoard);
+                    high[i] = eval.eval(0).code();
+                    low[i] = eval.eval(1).code();
+                }
+                flags = tally.add(&high[0], &low[0]);
+            }
+            else
             {
-                // we use memcpy here for a little speed bonus
-		        // NOTE: this could break subclass semantics
-                memcpy((void*)copydest, copysrc, ncopy);
-                for (size_t p = 0; p < ndists + nboards; p++)
-                    ehands[p] |= deck.peek(pe.getMask(p));
-
-                // TODO: do we need this if/else, or can we just use the if
-                // clause? A: need to rework tracking of whether a board is
-                // needed
-                if (nboards > 0)
-                    peval->evaluateShowdown(ehands, ehands[ndists], evals, results, weight);
+                for (size_t i = 0; i < ndists; i++)
+                    high[i] = peval.evaluateHand(ehands[i], showdownBoard).high().code();
+                flags = tally.add(&high[0]);
+            }
+            PENUM_STAT(countShowdown(counts, flags));
+            (void)flags;
+
+            nevals++;
+            next++;
+            if ((monitor || checkpoint) && nevals - published >= kPublishInterval)
+            {
+                published = nevals;
+                flush();
+                if (sliced)
+                {
+                    PartialEquity progress = snapshot(*base, begin, next, results, exact);
+                    if (checkpoint && checkpoint->due())
+                        checkpoint->save(progress);
+                    fraction = coveredFraction(progress);
+                    if (monitor && !monitor->update(fraction, nevals, progress.results()))
+                    {
+                        stopped = true;
+                        break;
+                    }
+                }
+                else
+                {
+                    fraction = start + (nevals - first) / npartitions / nsteps;
+                    if (monitor && !monitor->update(fraction, nevals, results))
+                    {
+                        stopped = true;
+                        break;
+                    }
+                }
+            }
+            PENUM_STAT(counts.partitions++);
+        } while (pe.next());
+        flush();
+        index += ndeals;
+    }
+    PENUM_STAT(counts.disjointRejects += o.filtered());
+
+    uint64_t done = stopped ? next : std::max(next, std::min(index, end));
+    if (monitor && sliced)
+    {
+        PartialEquity progress = snapshot(*base, begin, done, results, exact);
+        monitor->update(coveredFraction(progress), nevals, progress.results());
+    }
+    else if (monitor)
+    {
+        monitor->update(stopped ? fraction : 1.0, nevals, results);
+    }
+    PENUM_STAT(counts.evaluations[peval.id()] += counts.showdowns * ndists);
+    PENUM_STAT(finishStats(counts, timer, stats));
+    return done;
+}
+
+vector<EquityResult>
+ShowdownEnumerator::calculateEquityVsRange(const CardDistribution& heroes,
+                                           const CardDistribution& range,
+                                           const CardSet& board,
+                                           std::shared_ptr<PokerHandEvaluator> peval) const
+{
+    if (peval.get() == NULL)
+        throw runtime_error("ShowdownEnumerator, null evaluator");
+    if (peval->evaluationSize() != 1)
+        throw runtime_error("ShowdownEnumerator, range equity needs a high only game");
+    if (board.size() != peval->boardSize())
+        throw runtime_error("ShowdownEnumerator, range equity needs a complete board");
+
+    vector<RankedHand> hs = rankHands(heroes, board, *peval);
+    vector<RankedHand> rs = rankHands(range, board, *peval);
+
+    RemovalSums all, below, equal;
+    for (const RankedHand& r : rs)
+        all.add(r.mask, r.weight);
+
+    // sweep both lists in eval order, range hands below the current hero
+    // eval are wins, and those equal to it are ties
+    vector<EquityResult> results(heroes.size(), EquityResult());
+    size_t r = 0;
+    size_t h = 0;
+    while (h < hs.size())
+    {
+        int code = hs[h].code;
+        while (r < rs.size() && rs[r].code < code)
+        {
+            below.add(rs[r].mask, rs[r].weight);
+            r++;
+        }
+        equal.clear();
+        for (size_t e = r; e < rs.size() && rs[e].code == code; e++)
+            equal.add(rs[e].mask, rs[e].weight);
+
+        for (; h < hs.size() && hs[h].code == code; h++)
+        {
+            EquityResult& result = results[hs[h].index];
+            result.winShares = below.disjoint(hs[h].mask);
+            result.tieShares = 0.5 * equal.disjoint(hs[h].mask);
+            double total = all.disjoint(hs[h].mask);
+            if (total > 0.0)
+                result.equity = (result.winShares + result.tieShares) / total;
+        }
+    }
+    return results;
+}
+
+vector<EquityResult>
+ShowdownEnumerator::calculateEquityMatrix(const CardDistribution& rows,
+                                          const CardDistribution& cols,
+                                          const CardSet& board,
+                                          std::shared_ptr<PokerHandEvaluator> peval) const
+{
+    if (peval.get() == NULL)
+        throw runtime_error("ShowdownEnumerator, null evaluator");
+    const size_t nrows = rows.size();
+    const size_t ncols = cols.size();
+    for (size_t i = 0; i < nrows + ncols; i++)
+    {
+        const CardSet& hand = (i < nrows) ? rows[i] : cols[i - nrows];
+        if (hand.size() != peval->handSize())
+            throw runtime_error("ShowdownEnumerator, equity matrix needs complete hands");
+    }
+    if (board.size() > peval->boardSize())
+        throw runtime_error("ShowdownEnumerator, board is too large");
+
+    vector<EquityResult> results(nrows * ncols, EquityResult());
+    vector<size_t> runouts(nrows * ncols, 0);
+    vector<PokerHandEvaluation> rowEvals(nrows);
+    vector<PokerHandEvaluation> colEvals(ncols);
+    vector<bool> rowLive(nrows);
+    vector<bool> colLive(ncols);
+
+    SimpleDeck deck(peval->deck());
+    deck.remove(board);
+    vector<size_t> parts(1, peval->boardSize() - board.size());
+    PartitionEnumerator2 pe(deck.size(), parts);
+    do
+    {
+        CardSet runout = board | deck.peek(pe.getMask(0));
+        for (size_t i = 0; i < nrows; i++)
+        {
+            rowLive[i] = rows[i].disjoint(runout);
+            if (rowLive[i])
+                rowEvals[i] = peval->evaluateHand(rows[i], runout);
+        }
+        for (size_t j = 0; j < ncols; j++)
+        {
+            colLive[j] = cols[j].disjoint(runout);
+            if (colLive[j])
+                colEvals[j] = peval->evaluateHand(cols[j], runout);
+        }
+
+        for (size_t i = 0; i < nrows; i++)
+        {
+            if (!rowLive[i])
+                continue;
+            EquityResult* row = &results[i * ncols];
+            size_t* rowRunouts = &runouts[i * ncols];
+            for (size_t j = 0; j < ncols; j++)
+            {
+                if (!colLive[j] || rows[i].intersects(cols[j]))
+                    continue;
+                double s = shares(rowEvals[i], colEvals[j]);
+                if (s == 1.0)
+                    row[j].winShares += s;
                 else
-                    peval->evaluateShowdown(ehands, board, evals, results, weight);
-            } while (pe.next());
+                    row[j].tieShares += s;
+                rowRunouts[j]++;
+            }
         }
-    } while (o.next());
+    } while (pe.next());
 
+    for (size_t k = 0; k < results.size(); k++)
+        if (runouts[k] > 0)
+            results[k].equity =
+                (results[k].winShares + results[k].tieShares) / runouts[k];
     return results;
 }
 
+bool ShowdownEnumerator::isShowdown(const vector<CardDistribution>& dists,
+                                    const CardSet& board,
+                                    const PokerHandEvaluator& peval) const
+{
+    if (dists.size() != 2 || peval.evaluationSize() != 1 ||
+        board.size() != peval.boardSize())
+        return false;
+    for (const CardDistribution& dist : dists)
+        for (size_t i = 0; i < dist.size(); i++)
+            if (dist[i].size() != peval.handSize())
+                return false;
+    return true;
+}
+
 }  // namespace pokerstove
@@ -5,24 +5,235 @@
 #define PENUM_SHOWDOWNENUMERATOR_H_
 
 #include "CardDistribution.h"
+#include "PartialEquity.h"
 #include <pokerstove/peval/PokerHandEvaluator.h>
+#include <pokerstove/peval/ShowdownTally.h>
 #include <memory>
 #include <vector>
 
 namespace pokerstove
 {
+class EnumerationCheckpoint;
+class EnumerationMonitor;
+struct EnumerationStats;
+
+/**
+ * The shares one hand of a range won, and the weight of the pots it
+ * played for, which is its weight times the weight of the opposing
+ * hands it met, summed over the deals.
+ */
+struct ComboResult
+{
+    double winShares;
+    double tieShares;
+    double pots;
+
+    ComboResult()
+        : winShares(0.0)
+        , tieShares(0.0)
+        , pots(0.0)
+    {}
+
+    ComboResult& operator+=(const ComboResult& other)
+    {
+        winShares += other.winShares;
+        tieShares += other.tieShares;
+        pots += other.pots;
+        return *this;
+    }
+
+    double equity() const { return pots > 0.0 ? (winShares + tieShares) / pots : 0.0; }
+};
+
 class ShowdownEnumerator
 {
 public:
+    static const uint64_t ALL_SHOWDOWNS = UINT64_MAX;
+
     ShowdownEnumerator();
 
     /**
      * enumerate a poker scenario, with board support
+     *
+     * If a monitor is given, progress and a snapshot of the results are
+     * published to it periodically, and the enumeration stops early if
+     * the monitor is cancelled, returning the partial results.
+     *
+     * If stats are given, the counters for this run are added to them.
+     * Counters are only gathered in POKERSTOVE_STATS builds.
      */
     std::vector<EquityResult>
     calculateEquity(const std::vector<CardDistribution>& dists,
                     const CardSet& board,
-                    std::shared_ptr<PokerHandEvaluator> peval) const;
+                    std::shared_ptr<PokerHandEvaluator> peval,
+                    EnumerationMonitor* monitor = NULL,
+                    EnumerationStats* stats = NULL) const;
+
+    /**
+     * The same enumeration as calculateEquity, which also adds up the
+     * results of every hand of every distribution, so one run shows how
+     * each hand in a range does.  combos is resized to hold all of the
+     * hands, the hands of player i in distribution order starting at
+     * comboOffsets(dists)[i].
+     */
+    std::vector<EquityResult>
+    calculateComboEquity(const std::vector<CardDistribution>& dists,
+                         const CardSet& board,
+                         std::shared_ptr<PokerHandEvaluator> peval,
+                         std::vector<ComboResult>& combos,
+                         EnumerationMonitor* monitor = NULL,
+                         EnumerationStats* stats = NULL) const;
+
+    /**
+     * where the hands of each player start in the combo results, with
+     * the total number of hands at the end
+     */
+    static std::vector<size_t> comboOffsets(const std::vector<CardDistribution>& dists);
+
+    /**
+     * The same enumeration as calculateEquity, with the shares counted
+     * exactly in integer units of ExactEquityResult::UNITS_PER_POT.  The
+     * results do not depend on the order in which showdowns are summed,
+     * so partial results can be merged and compared bit for bit.
+     *
+     * Up to ShowdownTally::MAX_EXACT players are supported, and every hand
+     * weight must be a non-negative whole number, otherwise a
+     * runtime_error is thrown.  Progress snapshots given to the monitor
+     * are converted to shares.
+     */
+    std::vector<ExactEquityResult>
+    calculateExactEquity(const std::vector<CardDistribution>& dists,
+                         const CardSet& board,
+                         std::shared_ptr<PokerHandEvaluator> peval,
+                         EnumerationMonitor* monitor = NULL,
+                         EnumerationStats* stats = NULL) const;
+
+    /**
+     * The number of showdowns calculateEquity would evaluate, which is
+     * the space work units index into.  Throws a runtime_error if the
+     * count does not fit in 64 bits.
+     */
+    uint64_t countShowdowns(const std::vector<CardDistribution>& dists,
+                            const CardSet& board,
+                            std::shared_ptr<PokerHandEvaluator> peval) const;
+
+    /**
+     * Evaluate only the showdowns [begin,end) of the enumeration.  The
+     * showdowns are numbered in the order calculateEquity visits them,
+     * hand combinations in odometer order and the deals of each
+     * combination in PartitionEnumerator2 order, so a set of work units
+     * which covers [0,countShowdowns()) adds up to the full result.
+     * Combinations before the unit are skipped by their count, only the
+     * deals of the first combination are stepped through.
+     *
+     * If the monitor stops the run early, the part covers only the
+     * showdowns which were evaluated.  If a checkpoint is given the
+     * progress is saved to it as in resumePartialEquity.  Statistics
+     * cover the showdowns evaluated by this call.
+     */
+    PartialEquity
+    calculatePartialEquity(const std::vector<CardDistribution>& dists,
+                           const CardSet& board,
+                           std::shared_ptr<PokerHandEvaluator> peval,
+                           uint64_t begin,
+                           uint64_t end,
+                           bool exact = false,
+                           EnumerationMonitor* monitor = NULL,
+                           EnumerationCheckpoint* checkpoint = NULL,
+                           EnumerationStats* stats = NULL) const;
+
+    /**
+     * Continue a partial result, evaluating the showdowns of [begin,end)
+     * which it does not cover yet and merging them into it.  The part
+     * must come from the same enumeration, or a runtime_error is thrown.
+     *
+     * If a checkpoint is given, the part together with everything
+     * evaluated so far is saved to it whenever its interval has passed,
+     * and once more when the run ends or is stopped, so a run which is
+     * killed loses at most one interval of work.  Exact parts resume to
+     * the same result bit for bit, inexact ones up to rounding.
+     */
+    void resumePartialEquity(PartialEquity& part,
+                             const std::vector<CardDistribution>& dists,
+                             const CardSet& board,
+                             std::shared_ptr<PokerHandEvaluator> peval,
+                             uint64_t begin = 0,
+                             uint64_t end = ALL_SHOWDOWNS,
+                             EnumerationMonitor* monitor = NULL,
+                             EnumerationCheckpoint* checkpoint = NULL,
+                             EnumerationStats* stats = NULL) const;
+
+    /**
+     * Heads up equity of each hand in heroes against a whole range, for
+     * complete hands on a complete board.  Every hand is evaluated once,
+     * the evaluations are sorted, and the weight of the range which each
+     * hero beats or ties is found with card removal sums, so the cost is
+     * O(n log n) rather than one showdown per pair of hands.
+     *
+     * The result for each hero holds the range weight it beats in
+     * winShares, half the weight it ties in tieShares, and the fraction
+     * of the non-colliding range weight won in equity.  Heroes which
+     * collide with the board get an empty result.
+     *
+     * Only high games are supported, split pot games and incomplete
+     * boards throw a runtime_error.
+     */
+    std::vector<EquityResult>
+    calculateEquityVsRange(const CardDistribution& heroes,
+                           const CardDistribution& range,
+                           const CardSet& board,
+                           std::shared_ptr<PokerHandEvaluator> peval) const;
+
+    /**
+     * Pairwise heads up equities between every hand in rows and every
+     * hand in cols, returned as a row major rows.size() x cols.size()
+     * matrix.  Each runout of the board is dealt once, and every hand is
+     * evaluated once per runout, so the cost in evaluations is
+     * (rows + cols) * runouts rather than rows * cols * runouts.
+     *
+     * For each pair winShares counts the runouts won outright, tieShares
+     * the pot fractions from ties and split pots, and equity is their sum
+     * over the number of runouts.  Pairs which share cards with each
+     * other or the board are left empty.  All hands must be complete,
+     * partial hands throw a runtime_error.
+     */
+    std::vector<EquityResult>
+    calculateEquityMatrix(const CardDistribution& rows,
+                          const CardDistribution& cols,
+                          const CardSet& board,
+                          std::shared_ptr<PokerHandEvaluator> peval) const;
+
+private:
+    // calculateEquity, with the hands broken out into combos if given
+    std::vector<EquityResult> equity(const std::vector<CardDistribution>& dists,
+                                     const CardSet& board,
+                                     std::shared_ptr<PokerHandEvaluator> peval,
+                                     EnumerationMonitor* monitor,
+                                     EnumerationStats* stats,
+                                     std::vector<ComboResult>* combos) const;
+
+    // the general enumeration of the showdowns [begin,end), shares go to
+    // exact if it is given and to results otherwise, and to the hands'
+    // combos if they are given, returns the number of the first showdown
+    // which was not evaluated.  Checkpoints save base merged with the
+    // progress of this run, and a slice publishes that merge to the
+    // monitor, with the share of all showdowns it covers.
+    uint64_t enumerate(const std::vector<CardDistribution>& dists,
+                       const CardSet& board,
+                       const PokerHandEvaluator& peval,
+                       EnumerationMonitor* monitor,
+                       EnumerationStats* stats,
+                       uint64_t begin,
+                       uint64_t end,
+                       std::vector<EquityResult>& results,
+                       std::vector<ExactEquityResult>* exact,
+                       EnumerationCheckpoint* checkpoint,
+                       const PartialEquity* base,
+                       std::vector<ComboResult>* combos = NULL) const;
+
+    bool isShowdown(const std::vector<CardDistribution>& dists,
+                    const CardSet& board,
+                    const PokerHandEvaluator& peval) const;
 };
 }  // namespace pokerstove
 
@@ -0,0 +1,318 @@
+#include "ShowdownEnumerator.h"
+#include "RangeDistribution.h"
+#include <pokerstove/peval/Card.h>
+#include <pokerstove/peval/ShortDeckHandEvaluator.h>
+#include <pokerstove/util/combinations.h>
+#include <gtest/gtest.h>
+
+using namespace pokerstove;
+using namespace std;
+
+namespace
+{
+// one showdown per pair of hands, the way the enumerator does it
+vector<EquityResult> bruteForce(const CardDistribution& a,
+                                const CardDistribution& b,
+                                const CardSet& board,
+                                const PokerHandEvaluator& peval)
+{
+    vector<EquityResult> results(2, EquityResult());
+    vector<PokerHandEvaluation> evals(2);
+    vector<CardSet> hands(2);
+    for (size_t i = 0; i < a.size(); i++)
+        for (size_t j = 0; j < b.size(); j++)
+        {
+            hands[0] = a[i];
+            hands[1] = b[j];
+            if (hands[0].intersects(hands[1]) || hands[0].intersects(board) ||
+                hands[1].intersects(board))
+                continue;
+            peval.evaluateShowdown(hands, board, evals, results,
+                                   a[hands[0]] * b[hands[1]]);
+        }
+    return results;
+}
+}  // namespace
+
+TEST(ShowdownEnumerator, RiverRangeVsRange)
+{
+    std::shared_ptr<PokerHandEvaluator> peval = PokerHandEvaluator::alloc("h");
+    CardSet board("Kh9s4c2d2s");
+    RangeDistribution a, b;
+    ASSERT_TRUE(a.parse("22+,AKs,KQo=0.5"));
+    ASSERT_TRUE(b.parse("A2s+,K9o+,T9s=0.25"));
+
+    vector<CardDistribution> dists;
+    dists.push_back(a.data());
+    dists.push_back(b.data());
+    ShowdownEnumerator showdown;
+    vector<EquityResult> fast = showdown.calculateEquity(dists, board, peval);
+    vector<EquityResult> slow = bruteForce(a, b, board, *peval);
+    for (size_t i = 0; i < 2; i++)
+    {
+        EXPECT_NEAR(slow[i].winShares, fast[i].winShares, 1e-9);
+        EXPECT_NEAR(slow[i].tieShares, fast[i].tieShares, 1e-9);
+    }
+}
+
+TEST(ShowdownEnumerator, EquityVsRange)
+{
+    std::shared_ptr<PokerHandEvaluator> peval = PokerHandEvaluator::alloc("h");
+    CardSet board("7c8c9hTsJd");
+    CardDistribution all;
+    all.fill(2);
+    RangeDistribution range;
+    ASSERT_TRUE(range.parse("QQ+,AQs+,Q9s,T9s,72o=0.5"));
+
+    ShowdownEnumerator showdown;
+    vector<EquityResult> results =
+        showdown.calculateEquityVsRange(all, range, board, peval);
+    ASSERT_EQ(all.size(), results.size());
+    for (size_t i = 0; i < all.size(); i += 7)
+    {
+        CardDistribution hero(all[i]);
+        vector<EquityResult> expected = bruteForce(hero, range, board, *peval);
+        EXPECT_NEAR(expected[0].winShares, results[i].winShares, 1e-9);
+        EXPECT_NEAR(expected[0].tieShares, results[i].tieShares, 1e-9);
+    }
+
+    // the king high straight is the nuts
+    CardDistribution nuts(CardSet("QhKh"));
+    EXPECT_DOUBLE_EQ(
+        1.0, showdown.calculateEquityVsRange(nuts, range, board, peval)[0].equity);
+}
+
+TEST(ShowdownEnumerator, EquityVsRangeOmaha)
+{
+    std::shared_ptr<PokerHandEvaluator> peval = PokerHandEvaluator::alloc("O");
+    CardSet board("AcKd7h7s2c");
+    RangeDistribution heroes(4), range(4);
+    ASSERT_TRUE(heroes.parse("AAxxds"));
+    ASSERT_TRUE(range.parse("KKQQ,7xxx=0.01"));
+
+    ShowdownEnumerator showdown;
+    vector<EquityResult> results =
+        showdown.calculateEquityVsRange(heroes, range, board, peval);
+    for (size_t i = 0; i < heroes.size(); i += 11)
+    {
+        CardDistribution hero(heroes[i]);
+        vector<EquityResult> expected = bruteForce(hero, range, board, *peval);
+        EXPECT_NEAR(expected[0].winShares, results[i].winShares, 1e-9);
+        EXPECT_NEAR(expected[0].tieShares, results[i].tieShares, 1e-9);
+    }
+}
+
+TEST(ShowdownEnumerator, EquityVsRangeRequiresBoard)
+{
+    std::shared_ptr<PokerHandEvaluator> peval = PokerHandEvaluator::alloc("h");
+    CardDistribution hero(CardSet("AcAd"));
+    CardDistribution range(CardSet("KcKd"));
+    ShowdownEnumerator showdown;
+    EXPECT_THROW(showdown.calculateEquityVsRange(hero, range, CardSet("2c3c4c"), peval),
+                 std::runtime_error);
+}
+
+TEST(ShowdownEnumerator, EquityMatrix)
+{
+    std::shared_ptr<PokerHandEvaluator> peval = PokerHandEvaluator::alloc("h");
+    CardSet board("Qs7d2c5h");
+    RangeDistribution rows, cols;
+    ASSERT_TRUE(rows.parse("AA,KQs,76s"));
+    ASSERT_TRUE(cols.parse("QJs,55,AKo"));
+
+    ShowdownEnumerator showdown;
+    vector<EquityResult> matrix =
+        showdown.calculateEquityMatrix(rows, cols, board, peval);
+    ASSERT_EQ(rows.size() * cols.size(), matrix.size());
+    for (size_t i = 0; i < rows.size(); i++)
+        for (size_t j = 0; j < cols.size(); j++)
+        {
+            const EquityResult& cell = matrix[i * cols.size() + j];
+            if (rows[i].intersects(cols[j]) || rows[i].intersects(board) ||
+                cols[j].intersects(board))
+            {
+                EXPECT_EQ(0.0, cell.equity);
+                continue;
+            }
+            vector<CardDistribution> dists;
+            dists.push_back(CardDistribution(rows[i]));
+            dists.push_back(CardDistribution(cols[j]));
+            vector<EquityResult> pair = showdown.calculateEquity(dists, board, peval);
+            double equity = pair[0].shares() / (pair[0].shares() + pair[1].shares());
+            EXPECT_NEAR(equity, cell.equity, 1e-9);
+        }
+}
+
+TEST(ShowdownEnumerator, EquityMatrixHighLow)
+{
+    std::shared_ptr<PokerHandEvaluator> peval = PokerHandEvaluator::alloc("o");
+    CardSet board("Ac3d8hKs");
+    CardDistribution rows(CardSet("2c4cQdQh"));
+    CardDistribution cols(CardSet("KcKdJh9s"));
+
+    ShowdownEnumerator showdown;
+    vector<EquityResult> matrix =
+        showdown.calculateEquityMatrix(rows, cols, board, peval);
+    vector<CardDistribution> dists;
+    dists.push_back(rows);
+    dists.push_back(cols);
+    vector<EquityResult> pair = showdown.calculateEquity(dists, board, peval);
+    EXPECT_NEAR(pair[0].shares() / (pair[0].shares() + pair[1].shares()),
+                matrix[0].equity, 1e-9);
+}
+
+TEST(ShowdownEnumerator, ExactEquity)
+{
+    std::shared_ptr<PokerHandEvaluator> peval = PokerHandEvaluator::alloc("h");
+    RangeDistribution a, b, c;
+    ASSERT_TRUE(a.parse("AA,KK=2"));
+    ASSERT_TRUE(b.parse("AKs,QQ"));
+    ASSERT_TRUE(c.parse("JTs"));
+    vector<CardDistribution> dists;
+    dists.push_back(a.data());
+    dists.push_back(b.data());
+    dists.push_back(c.data());
+    CardSet board("Js8h2c");
+
+    ShowdownEnumerator showdown;
+    vector<EquityResult> shares = showdown.calculateEquity(dists, board, peval);
+    vector<ExactEquityResult> exact = showdown.calculateExactEquity(dists, board, peval);
+    ASSERT_EQ(3, exact.size());
+
+    // every showdown hands out a whole pot, times the weight
+    uint64_t units = 0;
+    double pots = 0.0;
+    for (size_t i = 0; i < exact.size(); i++)
+    {
+        EquityResult r = exact[i].result();
+        EXPECT_NEAR(shares[i].winShares, r.winShares, 1e-6);
+        EXPECT_NEAR(shares[i].tieShares, r.tieShares, 1e-6);
+        units += exact[i].units();
+        pots += shares[i].shares();
+    }
+    EXPECT_EQ(static_cast<uint64_t>(pots + 0.5) * ExactEquityResult::UNITS_PER_POT, units);
+
+    dists[2] = CardDistribution(CardSet("JcTc"));
+    dists[2].insert(CardSet("JdTd"), 0.5);
+    EXPECT_THROW(showdown.calculateExactEquity(dists, board, peval), runtime_error);
+}
+
+TEST(ShowdownEnumerator, ExactEquityHighLow)
+{
+    std::shared_ptr<PokerHandEvaluator> peval = PokerHandEvaluator::alloc("o");
+    vector<CardDistribution> dists;
+    dists.push_back(CardDistribution(CardSet("Ac2c3dKd")));
+    dists.push_back(CardDistribution(CardSet("Ad2d4hKh")));
+    dists.push_back(CardDistribution(CardSet("QhQsJhTs")));
+    CardSet board("5s9c7h");
+
+    ShowdownEnumerator showdown;
+    vector<EquityResult> shares = showdown.calculateEquity(dists, board, peval);
+    vector<ExactEquityResult> exact = showdown.calculateExactEquity(dists, board, peval);
+    uint64_t units = 0;
+    for (size_t i = 0; i < exact.size(); i++)
+    {
+        EXPECT_NEAR(shares[i].shares(), exact[i].result().shares(), 1e-6);
+        units += exact[i].units();
+    }
+    EXPECT_EQ(0, units % ExactEquityResult::UNITS_PER_POT);
+    EXPECT_EQ(choose(52 - 12 - 3, 2), units / ExactEquityResult::UNITS_PER_POT);
+}
+
+TEST(ShowdownEnumerator, ShortDeckTurn)
+{
+    std::shared_ptr<PokerHandEvaluator> peval = PokerHandEvaluator::alloc("6");
+    CardSet board("JhTh6c7d");
+    CardSet hero("AhKh");
+    CardSet villain("QsQd");
+
+    // the river only comes from the 36 card deck
+    vector<EquityResult> slow(2, EquityResult());
+    vector<PokerHandEvaluation> evals(2);
+    vector<CardSet> hands;
+    hands.push_back(hero);
+    hands.push_back(villain);
+    CardSet live = peval->deck() ^ board ^ hero ^ villain;
+    for (const Card& river : live.cards())
+        peval->evaluateShowdown(hands, board | CardSet(river), evals, slow);
+    EquityResult::normalize(slow);
+
+    vector<CardDistribution> dists(2);
+    dists[0].parse(hero.str());
+    dists[1].parse(villain.str());
+    ShowdownEnumerator showdown;
+    EXPECT_EQ(live.size(), showdown.countShowdowns(dists, board, peval));
+    vector<EquityResult> fast = showdown.calculateEquity(dists, board, peval);
+    EquityResult::normalize(fast);
+    for (size_t i = 0; i < 2; i++)
+        EXPECT_NEAR(slow[i].equity, fast[i].equity, 1e-9);
+}
+
+TEST(ShowdownEnumerator, ShortDeckRandomHand)
+{
+    // a random hand is dealt from the 36 card deck, as ps-eval fills it
+    std::shared_ptr<PokerHandEvaluator> peval = PokerHandEvaluator::alloc("6");
+    CardSet board("Jh9c6d");
+    vector<CardDistribution> dists(2);
+    dists[0].parse("AsKs");
+    dists[1].fill(peval->deck(), static_cast<int>(peval->handSize()));
+    EXPECT_EQ(choose(SHORT_DECK_SIZE, 2), dists[1].size());
+
+    ShowdownEnumerator showdown;
+    vector<EquityResult> results = showdown.calculateEquity(dists, board, peval);
+    int live = static_cast<int>(SHORT_DECK_SIZE) - 5;
+    double shares = 0.0;
+    for (const EquityResult& r : results)
+        shares += r.winShares + r.tieShares;
+    EXPECT_NEAR(choose(live, 2) * choose(live - 2, 2), shares, 1e-6);
+}
+
+TEST(ShowdownEnumerator, ComboEquity)
+{
+    std::shared_ptr<PokerHandEvaluator> peval = PokerHandEvaluator::alloc("h");
+    RangeDistribution a, b;
+    ASSERT_TRUE(a.parse("AKs,QQ=0.5"));
+    ASSERT_TRUE(b.parse("JJ,T9s=2"));
+
+    // each combo on its own against the other range, on the turn and on
+    // the river where heads up showdowns take a shortcut
+    const char* boards[] = {"Jd9h4c2s", "Jd9h4c2s3s"};
+    for (const char* cards : boards)
+    {
+        CardSet board(cards);
+        vector<CardDistribution> dists;
+        dists.push_back(a.data());
+        dists.push_back(b.data());
+        ShowdownEnumerator showdown;
+        vector<ComboResult> combos;
+        vector<EquityResult> all = showdown.calculateComboEquity(dists, board, peval, combos);
+        vector<EquityResult> plain = showdown.calculateEquity(dists, board, peval);
+        vector<size_t> offsets = ShowdownEnumerator::comboOffsets(dists);
+        ASSERT_EQ(a.size() + b.size(), combos.size());
+        ASSERT_EQ(a.size(), offsets[1]);
+
+        for (size_t p = 0; p < 2; p++)
+        {
+            EXPECT_NEAR(plain[p].winShares, all[p].winShares, 1e-9);
+            double shares = 0.0;
+            for (size_t h = 0; h < dists[p].size(); h++)
+            {
+                const ComboResult& combo = combos[offsets[p] + h];
+                shares += combo.winShares + combo.tieShares;
+                if (dists[p][h].intersects(board))
+                {
+                    EXPECT_EQ(0.0, combo.pots);
+                    continue;
+                }
+
+                vector<CardDistribution> one = dists;
+                one[p] = CardDistribution();
+                one[p].parse(dists[p][h].str());
+                vector<EquityResult> alone = showdown.calculateEquity(one, board, peval);
+                EquityResult::normalize(alone);
+                EXPECT_NEAR(alone[p].equity, combo.equity(), 1e-9) << cards << " " << dists[p][h].str();
+            }
+            EXPECT_NEAR(all[p].winShares + all[p].tieShares, shares, 1e-9);
+        }
+    }
+}
@@ -41,21 +41,24 @@ public:
      */
     SimpleDeck()
     {
-        for (uint8_t i = 0; i < STANDARD_DECK_SIZE; i++)
-        {
-            _deck[i] = CardSet(Card(i));
-        }
-        reset();
+        CardSet cards;
+        cards.fill();
+        init(cards);
+    }
 
-        std::random_device rd;
-        std::mt19937 g(rd());
-        _rand = g;
+    /**
+     * construct an in-order deck of just the given cards, for games like
+     * short deck which do not use all 52
+     */
+    explicit SimpleDeck(const CardSet& cards)
+    {
+        init(cards);
     }
 
     /**
      * put all dealt cards back into deck, don't reorder
      */
-    void reset() { _current = STANDARD_DECK_SIZE; }
+    void reset() { _current = _size; }
 
     /**
      * number of cards left in the deck
@@ -68,13 +71,13 @@ public:
     std::string str() const
     {
         std::string ret;
-        for (uint i = 0; i < STANDARD_DECK_SIZE; i++)
+        for (uint i = 0; i < _size; i++)
         {
             if (i == _current)
                 ret += "/";
             ret = ret + _deck[i].str();
         }
-        if (_current == STANDARD_DECK_SIZE)
+        if (_current == _size)
             ret += "/";
         return ret;
     }
@@ -96,7 +99,7 @@ public:
     pokerstove::CardSet dead() const
     {
         pokerstove::CardSet cs;
-        for (size_t i = _current; i < STANDARD_DECK_SIZE; i++)
+        for (size_t i = _current; i < _size; i++)
             cs.insert(_deck[i]);
         return cs;
     }
@@ -106,9 +109,9 @@ public:
      */
     void remove(const pokerstove::CardSet& cards)
     {
-        int decr = CardSet(cards | dead()).size();
-        stable_partition(_deck.begin(), _deck.end(), std::bind(isLive(), std::placeholders::_1, cards));
-        _current = STANDARD_DECK_SIZE - decr;
+        int decr = CardSet((cards | dead()) & _cards).size();
+        stable_partition(_deck.begin(), _deck.begin() + _size, std::bind(isLive(), std::placeholders::_1, cards));
+        _current = _size - decr;
     }
 
     /**
@@ -120,7 +123,7 @@ public:
 
     void shuffle()
     {
-        std::shuffle(_deck.begin(), _deck.end(), _rand);
+        std::shuffle(_deck.begin(), _deck.begin() + _size, _rand);
         reset();  //_current = 0;
     }
 
@@ -175,8 +178,23 @@ public:
     }
 
 private:
+    void init(const CardSet& cards)
+    {
+        _cards = cards;
+        _size = 0;
+        for (const Card& c : cards.cards())
+            _deck[_size++] = CardSet(c);
+        reset();
+
+        std::random_device rd;
+        std::mt19937 g(rd());
+        _rand = g;
+    }
+
     // these are the data which track info about the deck
     std::array<CardSet, STANDARD_DECK_SIZE> _deck;
+    CardSet _cards;
+    size_t _size;
     size_t _current;
 
     // source of randomness
@@ -48,3 +48,21 @@ TEST(SimpleDeck, shuffe)
     unshuffled26 |= unshuffled.deal(26).mask();
     EXPECT_EQ(shuffled26, unshuffled26);
 }
+
+TEST(SimpleDeck, short_deck)
+{
+    CardSet cards;
+    cards.fill();
+    cards ^= CardSet("2c3c4c5c2d3d4d5d2h3h4h5h2s3s4s5s");
+    SimpleDeck d(cards);
+    EXPECT_EQ(d.size(), 36);
+
+    // removing a card which is not in the deck changes nothing
+    d.remove(CardSet("2c"));
+    EXPECT_EQ(d.size(), 36);
+    d.remove(CardSet("Ac"));
+    EXPECT_EQ(d.size(), 35);
+
+    d.shuffle();
+    EXPECT_EQ(d.deal(36).mask(), cards.mask());
+}
@@ -0,0 +1,57 @@
+/**
+ * Copyright (c) 2012 Andrew Prock. All rights reserved.
+ */
+#include "StudEnumerator.h"
+
+#include <stdexcept>
+
+using std::runtime_error;
+using std::vector;
+
+namespace pokerstove
+{
+
+StudEnumerator::StudEnumerator()
+    : _draws()
+{}
+
+vector<DrawHand> StudEnumerator::hands(const vector<CardSet>& known,
+                                       const PokerHandEvaluator& peval) const
+{
+    // each player draws their unknown cards in a single round
+    vector<DrawHand> hands;
+    for (const CardSet& cards : known)
+    {
+        if (cards.size() > peval.handSize())
+            throw runtime_error("StudEnumerator, too many cards: " + cards.str());
+        size_t unknown = peval.handSize() - cards.size();
+        hands.push_back(DrawHand(cards, vector<size_t>(unknown > 0 ? 1 : 0, unknown)));
+    }
+    return hands;
+}
+
+double StudEnumerator::countDeals(const vector<CardSet>& known,
+                                  std::shared_ptr<PokerHandEvaluator> peval) const
+{
+    return _draws.countDeals(hands(known, *peval), peval);
+}
+
+vector<EquityResult>
+StudEnumerator::calculateEquity(const vector<CardSet>& known,
+                                std::shared_ptr<PokerHandEvaluator> peval,
+                                EnumerationMonitor* monitor) const
+{
+    return _draws.calculateEquity(hands(known, *peval), peval, monitor);
+}
+
+vector<EquityResult>
+StudEnumerator::sampleEquity(const vector<CardSet>& known,
+                             std::shared_ptr<PokerHandEvaluator> peval,
+                             uint64_t trials,
+                             unsigned int seed,
+                             EnumerationMonitor* monitor) const
+{
+    return _draws.sampleEquity(hands(known, *peval), peval, trials, seed, monitor);
+}
+
+}  // namespace pokerstove
@@ -0,0 +1,83 @@
+/**
+ * Copyright (c) 2012 Andrew Prock. All rights reserved.
+ */
+#ifndef PENUM_STUDENUMERATOR_H_
+#define PENUM_STUDENUMERATOR_H_
+
+#include <memory>
+#include <vector>
+#include <pokerstove/peval/CardSet.h>
+#include <pokerstove/peval/PokerHandEvaluator.h>
+#include "DrawEnumerator.h"
+
+namespace pokerstove
+{
+class EnumerationMonitor;
+
+/**
+ * Equity for stud, razz, and stud/8 part way through a hand.  Each
+ * player is given by the cards known so far, their up cards and, for the
+ * hero, their hole cards.  The cards folded players showed are dead.
+ * Only the unknown cards are dealt, every player's known cards are a
+ * fixed part of their hand and out of the deck for everyone else.
+ *
+ * The order cards come off the deck does not change who wins at
+ * showdown, so the unknown cards are dealt as one block per player.  Razz
+ * ignores suits and is walked by ranks, and for the other games deals
+ * which differ by a permutation of suits are walked once, see
+ * DrawEnumerator.
+ *
+ * A full table on third street is far too big to enumerate, sampleEquity
+ * is the way to get numbers for those.
+ */
+class StudEnumerator
+{
+public:
+    StudEnumerator();
+
+    /**
+     * the up cards of folded players, and any other cards known to be
+     * out of the deck
+     */
+    void setDead(const CardSet& dead) { _draws.setDead(dead); }
+    const CardSet& dead() const { return _draws.dead(); }
+
+    void setThreads(size_t threads) { _draws.setThreads(threads); }
+    size_t threads() const { return _draws.threads(); }
+
+    /**
+     * the number of ways to deal the unknown cards
+     */
+    double countDeals(const std::vector<CardSet>& known,
+                      std::shared_ptr<PokerHandEvaluator> peval) const;
+
+    /**
+     * Exact equity over every deal of the unknown cards.  Throws a
+     * runtime_error if the known cards collide, a player has more cards
+     * than the game deals, or the deck runs out.
+     */
+    std::vector<EquityResult>
+    calculateEquity(const std::vector<CardSet>& known,
+                    std::shared_ptr<PokerHandEvaluator> peval,
+                    EnumerationMonitor* monitor = NULL) const;
+
+    /**
+     * equity over the given number of random deals of the unknown cards
+     */
+    std::vector<EquityResult>
+    sampleEquity(const std::vector<CardSet>& known,
+                 std::shared_ptr<PokerHandEvaluator> peval,
+                 uint64_t trials,
+                 unsigned int seed = 0,
+                 EnumerationMonitor* monitor = NULL) const;
+
+private:
+    std::vector<DrawHand> hands(const std::vector<CardSet>& known,
+                                const PokerHandEvaluator& peval) const;
+
+    DrawEnumerator _draws;
+};
+
+}  // namespace pokerstove
+
+#endif  // PENUM_STUDENUMERATOR_H_
@@ -0,0 +1,119 @@
+#include "StudEnumerator.h"
+#include <stdexcept>
+#include <pokerstove/peval/Card.h>
+#include <pokerstove/peval/PokerHandEvaluation.h>
+#include <gtest/gtest.h>
+
+using namespace pokerstove;
+using namespace std;
+
+namespace
+{
+// the hero has six cards and the villain five, every way to finish both
+vector<EquityResult> bruteForce(const CardSet& hero,
+                                const CardSet& villain,
+                                const PokerHandEvaluator& peval)
+{
+    CardSet deck;
+    deck.fill();
+    vector<Card> live = CardSet(deck ^ hero ^ villain).cards();
+    vector<EquityResult> results(2);
+    vector<PokerHandEvaluation> evals(2);
+    vector<CardSet> hands(2);
+    for (size_t i = 0; i < live.size(); i++)
+        for (size_t j = 0; j < live.size(); j++)
+            for (size_t k = j + 1; k < live.size(); k++)
+            {
+                if (i == j || i == k)
+                    continue;
+                hands[0] = hero | CardSet(live[i]);
+                hands[1] = villain | CardSet(live[j]) | CardSet(live[k]);
+                peval.evaluateShowdown(hands, CardSet(), evals, results);
+            }
+    EquityResult::normalize(results);
+    return results;
+}
+
+void expectBruteForce(const string& game, const CardSet& hero, const CardSet& villain)
+{
+    std::shared_ptr<PokerHandEvaluator> peval = PokerHandEvaluator::alloc(game);
+    vector<CardSet> known;
+    known.push_back(hero);
+    known.push_back(villain);
+
+    StudEnumerator stud;
+    vector<EquityResult> fast = stud.calculateEquity(known, peval);
+    vector<EquityResult> slow = bruteForce(hero, villain, *peval);
+    for (size_t i = 0; i < 2; i++)
+        EXPECT_NEAR(slow[i].equity, fast[i].equity, 1e-9) << game << " " << i;
+}
+}  // namespace
+
+TEST(StudEnumerator, SixthStreet)
+{
+    expectBruteForce("s", CardSet("AcKd9h9s2c3d"), CardSet("QsQhJd8c7c"));
+    expectBruteForce("r", CardSet("Ac2d3h4s9cTd"), CardSet("2s3s5d6h7c"));
+    expectBruteForce("e", CardSet("Ac2d3h9s9cTd"), CardSet("2s3s5d5hKc"));
+}
+
+TEST(StudEnumerator, SymmetricSuits)
+{
+    // clubs and diamonds can be swapped without moving a known card
+    expectBruteForce("s", CardSet("AcAdKcKd2h3h"), CardSet("QcQdJcJd9s"));
+}
+
+TEST(StudEnumerator, DeadCards)
+{
+    std::shared_ptr<PokerHandEvaluator> peval = PokerHandEvaluator::alloc("s");
+    vector<CardSet> known;
+    known.push_back(CardSet("AcKd9h9s2c3d"));
+    known.push_back(CardSet("QsQhJd8c7c"));
+
+    // with both queens dead the villain needs help from the board
+    StudEnumerator stud;
+    vector<EquityResult> live = stud.calculateEquity(known, peval);
+    stud.setDead(CardSet("QcQd"));
+    vector<EquityResult> dead = stud.calculateEquity(known, peval);
+    EXPECT_LT(dead[1].equity, live[1].equity);
+
+    double n = STANDARD_DECK_SIZE - 13;
+    EXPECT_EQ(n * (n - 1) * (n - 2) / 2, stud.countDeals(known, peval));
+}
+
+TEST(StudEnumerator, SevenPlayersSampled)
+{
+    std::shared_ptr<PokerHandEvaluator> peval = PokerHandEvaluator::alloc("s");
+    vector<CardSet> known;
+    known.push_back(CardSet("AcAdKh"));
+    known.push_back(CardSet("Qs"));
+    known.push_back(CardSet("Jh"));
+    known.push_back(CardSet("Tc"));
+    known.push_back(CardSet("9d"));
+    known.push_back(CardSet("8s"));
+    known.push_back(CardSet("7h"));
+
+    StudEnumerator stud;
+    stud.setThreads(2);
+    vector<EquityResult> results = stud.sampleEquity(known, peval, 20000, 1);
+    ASSERT_EQ(7, results.size());
+    double total = 0.0;
+    for (size_t i = 0; i < results.size(); i++)
+        total += results[i].equity;
+    EXPECT_NEAR(1.0, total, 1e-9);
+    for (size_t i = 1; i < results.size(); i++)
+        EXPECT_GT(results[0].equity, results[i].equity);
+}
+
+TEST(StudEnumerator, InvalidHands)
+{
+    std::shared_ptr<PokerHandEvaluator> peval = PokerHandEvaluator::alloc("s");
+    StudEnumerator stud;
+
+    vector<CardSet> eight(1, CardSet("AcKcQcJcTc9c8c7c"));
+    EXPECT_THROW(stud.calculateEquity(eight, peval), runtime_error);
+
+    vector<CardSet> collide;
+    collide.push_back(CardSet("AcKd"));
+    collide.push_back(CardSet("AcQd"));
+    EXPECT_THROW(stud.calculateEquity(collide, peval), runtime_error);
+}
@@ -0,0 +1,56 @@
+/**
+ * Copyright (c) 2012 Andrew Prock. All rights reserved.
+ */
+#ifndef PEVAL_BIGOMAHAHANDEVALUATOR_H_
+#define PEVAL_BIGOMAHAHANDEVALUATOR_H_
+
+#include <cstdint>
+#include "OmahaEightHandEvaluator.h"
+#include "OmahaSubsets.h"
+#include "PokerHandEvaluator.h"
+
+namespace pokerstove
+{
+/**
+ * A specialized hand evaluator for five and six card omaha, high only or
+ * high/low 8 or better.  The player must use exactly two of their cards
+ * and three from the board.
+ *
+ * Subsets are built with the OmahaSubsets helpers into stack arrays, and
+ * the low half uses the OmahaEightHandEvaluator low table, so no
+ * evaluation allocates.
+ */
+template <int POCKET, bool EIGHT>
+class BigOmahaHandEvaluator : public PokerHandEvaluator
+{
+public:
+    static const int NUM_OMAHA_POCKET = POCKET;
+    static const int NUM_OMAHA_RIVER = 5;
+    static const int MAX_PAIRS = POCKET * (POCKET - 1) / 2;
+    static const int MAX_TRIPLES = 10;
+
+    virtual PokerHandEvaluation evaluateHand(const CardSet& hand, const CardSet& board) const
+    {
+        uint64_t hands[MAX_PAIRS];
+        uint64_t boards[MAX_TRIPLES];
+        size_t nhands = omahaHandPairs<POCKET>(hand, hands);
+        size_t nboards = omahaBoardTriples(board, boards);
+
+        PokerEvaluation high = omahaBestHigh(hands, nhands, boards, nboards);
+        if (!EIGHT)
+            return PokerHandEvaluation(high);
+        return PokerHandEvaluation(high, OmahaEightHandEvaluator::bestLow(hands, nhands, board));
+    }
+
+    virtual size_t handSize() const { return NUM_OMAHA_POCKET; }
+    virtual size_t boardSize() const { return NUM_OMAHA_RIVER; }
+    virtual size_t evaluationSize() const { return EIGHT ? 2 : 1; }
+};
+
+typedef BigOmahaHandEvaluator<5, false> Omaha5HighHandEvaluator;
+typedef BigOmahaHandEvaluator<5, true> Omaha5EightHandEvaluator;
+typedef BigOmahaHandEvaluator<6, false> Omaha6HighHandEvaluator;
+typedef BigOmahaHandEvaluator<6, true> Omaha6EightHandEvaluator;
+
+}  // namespace pokerstove
+#endif  // PEVAL_BIGOMAHAHANDEVALUATOR_H_
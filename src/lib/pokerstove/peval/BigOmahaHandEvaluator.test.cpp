@@ -0,0 +1,85 @@
+#include "BigOmahaHandEvaluator.h"
+#include "Card.h"
+#include "UniversalHandEvaluator.h"
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace pokerstove;
+using namespace std;
+
+namespace
+{
+// compare against the generic evaluator on random deals with boards of
+// three to five cards
+template <class Evaluator>
+void checkUniversal(const UniversalHandEvaluator& universal, unsigned int seed)
+{
+    Evaluator eval;
+    mt19937 rng(seed);
+    uniform_int_distribution<int> card(0, STANDARD_DECK_SIZE - 1);
+    for (int trial = 0; trial < 1000; trial++)
+    {
+        size_t boardSize = 3 + trial % 3;
+        CardSet dealt;
+        while (dealt.size() < eval.handSize() + boardSize)
+            dealt.insert(Card(static_cast<uint8_t>(card(rng))));
+        vector<Card> cards = dealt.cards();
+        CardSet hand, board;
+        for (size_t i = 0; i < cards.size(); i++)
+            (i < eval.handSize() ? hand : board).insert(cards[i]);
+
+        PokerHandEvaluation expected = universal.evaluateHand(hand, board);
+        PokerHandEvaluation actual = eval.evaluateHand(hand, board);
+        EXPECT_EQ(expected.high().code(), actual.high().code())
+            << hand.str() << " " << board.str();
+        EXPECT_EQ(expected.low().code(), actual.low().code())
+            << hand.str() << " " << board.str();
+    }
+}
+}  // namespace
+
+TEST(BigOmahaHandEvaluator, Construct)
+{
+    Omaha6EightHandEvaluator eval;
+    EXPECT_EQ(true, eval.usesSuits());
+    EXPECT_EQ(6, eval.handSize());
+    EXPECT_EQ(5, eval.boardSize());
+    EXPECT_EQ(2, eval.evaluationSize());
+}
+
+TEST(BigOmahaHandEvaluator, TwoFromHand)
+{
+    // four hearts in the hand make no flush without three on the board
+    Omaha5HighHandEvaluator eval;
+    CardSet hand("AhKhQhJh2c");
+    CardSet board("Th3d4s8c9h");
+    EXPECT_EQ(STRAIGHT, eval.evaluateHand(hand, board).high().type());
+}
+
+TEST(BigOmahaHandEvaluator, Omaha5High)
+{
+    checkUniversal<Omaha5HighHandEvaluator>(
+        UniversalHandEvaluator(5, 5, 3, 5, 2, &CardSet::evaluateHigh, NULL), 5);
+}
+
+TEST(BigOmahaHandEvaluator, Omaha6High)
+{
+    checkUniversal<Omaha6HighHandEvaluator>(
+        UniversalHandEvaluator(6, 6, 3, 5, 2, &CardSet::evaluateHigh, NULL), 6);
+}
+
+TEST(BigOmahaHandEvaluator, Omaha5Eight)
+{
+    checkUniversal<Omaha5EightHandEvaluator>(
+        UniversalHandEvaluator(5, 5, 3, 5, 2, &CardSet::evaluateHigh,
+                               &CardSet::evaluate8LowA5),
+        58);
+}
+
+TEST(BigOmahaHandEvaluator, Omaha6Eight)
+{
+    checkUniversal<Omaha6EightHandEvaluator>(
+        UniversalHandEvaluator(6, 6, 3, 5, 2, &CardSet::evaluateHigh,
+                               &CardSet::evaluate8LowA5),
+        68);
+}
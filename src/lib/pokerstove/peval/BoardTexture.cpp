@@ -0,0 +1,173 @@
+/**
+ * Copyright (c) 2012 Andrew Prock. All rights reserved.
+ */
+#include "BoardTexture.h"
+
+#include <stdexcept>
+#include "Card.h"
+#include "Suit.h"
+#include <pokerstove/util/combinations.h>
+
+using namespace std;
+
+namespace pokerstove
+{
+
+namespace
+{
+const size_t kRiver = 5;
+
+/**
+ * The parts of a board every hand on it shares.
+ */
+struct BoardParts
+{
+    CardSet board;
+    int type;
+    bool draws;
+
+    explicit BoardParts(const CardSet& b)
+        : board(b)
+        , type(b.evaluateHigh().type())
+        , draws(b.size() < kRiver)
+    {}
+
+    HandClass classify(const CardSet& hand) const
+    {
+        HandClass ret;
+        CardSet all = hand | board;
+        ret.type = all.evaluateHigh().type();
+        ret.improves = ret.type > type;
+        if (!draws)
+            return ret;
+
+        if (ret.type < STRAIGHT)
+            ret.straightOuts = all.evaluateStraightOuts();
+        if (ret.type < FLUSH)
+            for (Suit s = Suit::begin(); s < Suit::end(); ++s)
+                if (all.count(s) == 4 && hand.count(s) > 0)
+                    ret.flushDraw = true;
+        return ret;
+    }
+};
+}  // namespace
+
+BoardTexture::BoardTexture(size_t boardSize)
+    : _boardSize(boardSize)
+    , _codes()
+{
+    if (boardSize < 3 || boardSize > kRiver)
+        throw invalid_argument("BoardTexture, boards have three to five cards");
+
+    _codes.assign(static_cast<size_t>(choose(STANDARD_DECK_SIZE, boardSize)), 0);
+    combinations cards(STANDARD_DECK_SIZE, boardSize);
+    do
+    {
+        CardSet board(cards.getMask());
+        _codes[board.colex()] = static_cast<uint16_t>(evaluate(board));
+    } while (cards.next());
+}
+
+int BoardTexture::evaluate(const CardSet& board)
+{
+    int code = board.topRank().code() << HIGH_SHIFT;
+
+    // ranks held by two or more suits
+    int c = board.suitMask(Suit::Clubs());
+    int d = board.suitMask(Suit::Diamonds());
+    int h = board.suitMask(Suit::Hearts());
+    int s = board.suitMask(Suit::Spades());
+    int pairs = (c & d) | (c & h) | (c & s) | (d & h) | (d & s) | (h & s);
+    if (pairs)
+        code |= PAIRED;
+    if (pairs & (pairs - 1))
+        code |= TWO_PAIRED;
+    if (board.countMaxRank() >= 3)
+        code |= TRIPS;
+
+    size_t suited = board.countMaxSuit();
+    if (suited == board.size())
+        code |= MONOTONE;
+    if (suited >= 3)
+        code |= FLUSH_POSSIBLE;
+    else if (suited == 2)
+        code |= TWO_TONE;
+
+    // the most ranks in any window of five, with the ace both low and high
+    const int nranks = static_cast<int>(Rank::NUM_RANK);
+    int ranks = board.rankMask();
+    int wheel = (ranks << 1) | (ranks >> (nranks - 1) & 0x01);
+    size_t connected = 0;
+    for (int low = 0; low + 5 <= nranks + 1; low++)
+    {
+        size_t n = 0;
+        for (int i = low; i < low + 5; i++)
+            if (wheel & (0x01 << i))
+                n++;
+        connected = max(connected, n);
+    }
+    if (connected >= 2)
+        code |= CONNECTED;
+    if (connected >= 3)
+        code |= STRAIGHT_POSSIBLE;
+    return code;
+}
+
+string BoardTexture::str(int code)
+{
+    string ret = highRank(code).str() + " high";
+    if (code & TRIPS)
+        ret += ", trips";
+    else if (code & TWO_PAIRED)
+        ret += ", two paired";
+    else if (code & PAIRED)
+        ret += ", paired";
+    if (code & MONOTONE)
+        ret += ", monotone";
+    else if (code & FLUSH_POSSIBLE)
+        ret += ", flush possible";
+    else if (code & TWO_TONE)
+        ret += ", two tone";
+    else
+        ret += ", rainbow";
+    if (code & STRAIGHT_POSSIBLE)
+        ret += ", straight possible";
+    else if (code & CONNECTED)
+        ret += ", connected";
+    return ret;
+}
+
+vector<HandClass> BoardTexture::classify(const vector<CardSet>& hands,
+                                         const CardSet& board)
+{
+    BoardParts parts(board);
+    vector<HandClass> ret;
+    ret.reserve(hands.size());
+    for (const CardSet& hand : hands)
+        ret.push_back(parts.classify(hand));
+    return ret;
+}
+
+vector<HandClass> BoardTexture::classify(const vector<CardSet>& hands,
+                                         const vector<CardSet>& boards)
+{
+    if (hands.size() != boards.size())
+        throw invalid_argument("BoardTexture, one board is needed per hand");
+
+    vector<HandClass> ret;
+    ret.reserve(hands.size());
+    if (hands.empty())
+        return ret;
+
+    // hands are often grouped by board
+    BoardParts parts(boards[0]);
+    for (size_t i = 0; i < hands.size(); i++)
+    {
+        if (!(boards[i] == parts.board))
+            parts = BoardParts(boards[i]);
+        ret.push_back(parts.classify(hands[i]));
+    }
+    return ret;
+}
+
+}  // namespace pokerstove
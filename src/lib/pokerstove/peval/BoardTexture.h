@@ -0,0 +1,95 @@
+/**
+ * Copyright (c) 2012 Andrew Prock. All rights reserved.
+ */
+#ifndef PEVAL_BOARDTEXTURE_H_
+#define PEVAL_BOARDTEXTURE_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "CardSet.h"
+#include "PokerEvaluation.h"
+
+namespace pokerstove
+{
+/**
+ * The made hand class of a hold'em hand on a board, for reporting.
+ */
+struct HandClass
+{
+    int type;          //!< PokerEvaluation::type() of the best hand
+    int straightOuts;  //!< CardSet::evaluateStraightOuts() before the river, 0 with a straight made
+    bool flushDraw;    //!< four to a flush using a hole card before the river, no flush made
+    bool improves;     //!< the type is better than the board's own
+
+    HandClass()
+        : type(NO_PAIR)
+        , straightOuts(0)
+        , flushDraw(false)
+        , improves(false)
+    {}
+};
+
+/**
+ * Texture codes of hold'em boards, a set of flags with the top rank of
+ * the board above them.  Textures do not depend on suit permutations, so
+ * every board in a canonical class has the same code.
+ *
+ * A BoardTexture computes the code of every board of one size up front,
+ * indexed by the colex of the board, so a lookup is a colex and a read.
+ * A river table is about 5MB.
+ */
+class BoardTexture
+{
+public:
+    static const int PAIRED = 0x01;             //!< two or more cards of a rank
+    static const int TWO_PAIRED = 0x02;         //!< two ranks paired
+    static const int TRIPS = 0x04;              //!< three or more cards of a rank
+    static const int MONOTONE = 0x08;           //!< every card one suit
+    static const int TWO_TONE = 0x10;           //!< at most two cards of any suit, and two of some suit
+    static const int FLUSH_POSSIBLE = 0x20;     //!< three or more cards of a suit
+    static const int CONNECTED = 0x40;          //!< two ranks within a five rank straight
+    static const int STRAIGHT_POSSIBLE = 0x80;  //!< three ranks within a five rank straight
+    static const int HIGH_SHIFT = 8;            //!< top rank code above the flags
+
+    /**
+     * build the table for boards of the given size, [3,5]
+     */
+    explicit BoardTexture(size_t boardSize);
+
+    size_t boardSize() const { return _boardSize; }
+
+    /**
+     * the texture of a board of boardSize() cards
+     */
+    int texture(const CardSet& board) const { return _codes[board.colex()]; }
+
+    /**
+     * compute the texture of a board directly
+     */
+    static int evaluate(const CardSet& board);
+
+    static Rank highRank(int code)
+    {
+        return Rank(static_cast<uint8_t>(code >> HIGH_SHIFT & 0x0F));
+    }
+    static std::string str(int code);
+
+    /**
+     * Made hand classes of many hands on one board, or of each hand on
+     * the board with the same index.  The board parts are worked out once
+     * per board.
+     */
+    static std::vector<HandClass> classify(const std::vector<CardSet>& hands,
+                                           const CardSet& board);
+    static std::vector<HandClass> classify(const std::vector<CardSet>& hands,
+                                           const std::vector<CardSet>& boards);
+
+private:
+    size_t _boardSize;
+    std::vector<uint16_t> _codes;
+};
+
+}  // namespace pokerstove
+
+#endif  // PEVAL_BOARDTEXTURE_H_
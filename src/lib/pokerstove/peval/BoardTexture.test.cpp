@@ -0,0 +1,91 @@
+#include "BoardTexture.h"
+#include <stdexcept>
+#include <gtest/gtest.h>
+
+using namespace pokerstove;
+using namespace std;
+
+TEST(BoardTexture, Evaluate)
+{
+    EXPECT_EQ(BoardTexture::MONOTONE | BoardTexture::FLUSH_POSSIBLE |
+                  BoardTexture::CONNECTED | BoardTexture::STRAIGHT_POSSIBLE |
+                  Rank::Ace().code() << BoardTexture::HIGH_SHIFT,
+              BoardTexture::evaluate(CardSet("AhKhQh")));
+    EXPECT_EQ(BoardTexture::PAIRED | Rank::Seven().code() << BoardTexture::HIGH_SHIFT,
+              BoardTexture::evaluate(CardSet("7c7d2h")));
+
+    // the ace plays low in the wheel
+    int wheel = BoardTexture::evaluate(CardSet("As2d3c"));
+    EXPECT_TRUE(wheel & BoardTexture::STRAIGHT_POSSIBLE);
+    EXPECT_EQ(Rank::Ace(), BoardTexture::highRank(wheel));
+
+    int turn = BoardTexture::evaluate(CardSet("9c9d4h4c"));
+    EXPECT_TRUE(turn & BoardTexture::TWO_PAIRED);
+    EXPECT_TRUE(turn & BoardTexture::TWO_TONE);
+    EXPECT_FALSE(turn & BoardTexture::TRIPS);
+    EXPECT_FALSE(turn & BoardTexture::CONNECTED);
+
+    EXPECT_EQ("A high, monotone, straight possible",
+              BoardTexture::str(BoardTexture::evaluate(CardSet("AhKhQh"))));
+    EXPECT_EQ("7 high, paired, rainbow",
+              BoardTexture::str(BoardTexture::evaluate(CardSet("7c7d2h"))));
+}
+
+TEST(BoardTexture, Table)
+{
+    BoardTexture flops(3);
+    EXPECT_EQ(3, flops.boardSize());
+    const char* boards[] = {"AhKhQh", "7c7d2h", "As2d3c", "Td9s2s", "2c2d2h"};
+    for (const char* b : boards)
+    {
+        CardSet board(b);
+        EXPECT_EQ(BoardTexture::evaluate(board), flops.texture(board)) << b;
+        EXPECT_EQ(flops.texture(board), flops.texture(board.canonize())) << b;
+        EXPECT_EQ(flops.texture(board),
+                  flops.texture(board.rotateSuits(3, 2, 1, 0))) << b;
+    }
+    EXPECT_THROW(BoardTexture(6), invalid_argument);
+}
+
+TEST(BoardTexture, Classify)
+{
+    vector<CardSet> hands;
+    hands.push_back(CardSet("AsQs"));
+    hands.push_back(CardSet("8c8d"));
+    hands.push_back(CardSet("Tc9c"));
+    hands.push_back(CardSet("Ac2c"));
+
+    CardSet flop("Js8s3d");
+    vector<HandClass> classes = BoardTexture::classify(hands, flop);
+    ASSERT_EQ(4, classes.size());
+    EXPECT_EQ(NO_PAIR, classes[0].type);
+    EXPECT_TRUE(classes[0].flushDraw);
+    EXPECT_FALSE(classes[0].improves);
+    EXPECT_EQ(THREE_OF_A_KIND, classes[1].type);
+    EXPECT_TRUE(classes[1].improves);
+    EXPECT_FALSE(classes[1].flushDraw);
+    EXPECT_EQ(8, classes[2].straightOuts);
+    EXPECT_FALSE(classes[3].flushDraw);
+
+    // no draws on the river
+    CardSet river("Js8s3d7sKh");
+    classes = BoardTexture::classify(hands, river);
+    EXPECT_EQ(FLUSH, classes[0].type);
+    EXPECT_EQ(STRAIGHT, classes[2].type);
+    EXPECT_EQ(0, classes[3].straightOuts);
+
+    // pairs match the single board classification
+    vector<CardSet> boards(hands.size(), flop);
+    boards[3] = river;
+    classes = BoardTexture::classify(hands, boards);
+    vector<HandClass> onFlop = BoardTexture::classify(hands, flop);
+    for (size_t i = 0; i < 3; i++)
+    {
+        EXPECT_EQ(onFlop[i].type, classes[i].type);
+        EXPECT_EQ(onFlop[i].straightOuts, classes[i].straightOuts);
+        EXPECT_EQ(onFlop[i].flushDraw, classes[i].flushDraw);
+    }
+    EXPECT_EQ(NO_PAIR, classes[3].type);
+    EXPECT_THROW(BoardTexture::classify(hands, vector<CardSet>(1, flop)),
+                 invalid_argument);
+}
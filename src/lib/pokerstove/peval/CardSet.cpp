@@ -7,6 +7,7 @@
 #include "PokerEvaluation.h"
 #include "PokerEvaluationTables.h"
 #include "Rank.h"
+#include "RankMultisetIndex.h"
 #include "Suit.h"
 #include <algorithm>
 #include <array>
@@ -18,6 +19,7 @@
 #include <iostream>
 #include <limits>
 #include <pokerstove/util/combinations.h>
+#include <pokerstove/util/lastbit.h>
 #include <set>
 #include <vector>
 
@@ -831,89 +833,139 @@ PokerEvaluation CardSet::evaluatePairing() const
     return PokerEvaluation(0);
 }
 
-// This one is not fully optimized
-PokerEvaluation CardSet::evaluateLow2to7() const
+namespace
 {
-    PokerEvaluation high;
+// Lowball evaluations of paired hands depend only on the rank multiset of
+// the hand, so we look them up by its index among the multisets of up to
+// LOW_TABLE_CARDS cards.
+const int LOW_TABLE_CARDS = 7;
 
-    // if there are five or fewer cards, we just evaluate the high,
-    // fix the wheel, and take the complement
-    switch (size()) {
-    case 0:
-    case 1:
-    case 2:
-    case 3:
-    case 4:
-        high = evaluateHigh();
-        break;
+typedef RankMultisetIndex<Rank::NUM_RANK, LOW_TABLE_CARDS> MultisetIndex;
 
-    case 5:
-        high = evaluateHigh();
-        high.fixWheel2to7(rankMask());
-        break;
+// c, d, h, s are the suit rank masks of a hand of at most
+// LOW_TABLE_CARDS cards
+int rankMultisetIndex(int c, int d, int h, int s)
+{
+    return MultisetIndex::instance().index(c, d, h, s);
+}
 
-    default:
-        // this is a slow way to handle the general case.
-        // TODO: specialize the code for the 6 and 7 card cases.
-        vector<Card> cards = this->cards();
-        combinations combo(size(), FULL_HAND_SIZE);
-        PokerEvaluation best;
-        do {
-            CardSet candidate;
-            for (size_t i = 0; i < static_cast<size_t>(FULL_HAND_SIZE); i++)
-                candidate.insert(cards[combo[i]]);
-            PokerEvaluation e = candidate.evaluateLow2to7();
-            if (e > best)
-                best = e;
-        } while (combo.next());
-        return best;
-    }
+int rankMultisetIndex(uint64_t mask)
+{
+    return rankMultisetIndex(static_cast<int>(mask) & 0x1FFF,
+                             static_cast<int>(mask >> Rank::NUM_RANK) & 0x1FFF,
+                             static_cast<int>(mask >> 2 * Rank::NUM_RANK) & 0x1FFF,
+                             static_cast<int>(mask >> 3 * Rank::NUM_RANK) & 0x1FFF);
+}
 
-    high.flip();
-    return high;
+// 2-7 lowball for hands of up to five cards, see
+// CardSet::lowball2to7Table.  Unpaired hands are looked up by rank mask,
+// in the flush part if all five cards share a suit.  Paired hands can not
+// be flushes and are looked up by rank multiset.
+const int LOW27_RANKS = 0;
+const int LOW27_FLUSH = 1 << Rank::NUM_RANK;
+const int LOW27_PAIRED = 2 << Rank::NUM_RANK;
+}  // namespace
+
+const int* CardSet::lowball2to7Table()
+{
+    static const vector<int> table = []() {
+        auto evaluate = [](const CardSet& cards, bool useSuits) {
+            PokerEvaluation high = useSuits ? cards.evaluateHigh() : cards.evaluateHighRanks();
+            if (cards.size() == FULL_HAND_SIZE)
+                high.fixWheel2to7(cards.rankMask());
+            high.flip();
+            return high.code();
+        };
+
+        vector<int> ret(LOW27_PAIRED + MultisetIndex::instance().offset(FULL_HAND_SIZE + 1), 0);
+        for (int m = 0; m < (1 << Rank::NUM_RANK); m++)
+        {
+            if (nRanksTable[m] > FULL_HAND_SIZE)
+                continue;
+            // spread the ranks over the suits, and all in clubs for a flush
+            uint64_t spread = 0;
+            int k = 0;
+            for (int r = 0; r < static_cast<int>(Rank::NUM_RANK); r++)
+                if (m & (1 << r))
+                    spread |= ONE64 << (r + Rank::NUM_RANK * (k++ % 4));
+            ret[LOW27_RANKS + m] = evaluate(CardSet(spread), false);
+            if (nRanksTable[m] == FULL_HAND_SIZE)
+                ret[LOW27_FLUSH + m] = evaluate(CardSet(static_cast<uint64_t>(m)), true);
+        }
+        for (uint64_t mask : MultisetIndex::multisets(FULL_HAND_SIZE))
+            ret[LOW27_PAIRED + rankMultisetIndex(mask)] = evaluate(CardSet(mask), false);
+        return ret;
+    }();
+    return table.data();
 }
 
-// This one is not fully optimized
-PokerEvaluation CardSet::evaluateRanksLow2to7() const
+PokerEvaluation CardSet::evaluateLow2to7() const
 {
-    PokerEvaluation high;
-    PokerEvaluation h;
+    // five or fewer cards come from the table, which holds the
+    // complement of the high evaluation with the wheel fixed
+    int c = C();
+    int d = D();
+    int h = H();
+    int s = S();
+    int rankmask = c | d | h | s;
+    int ncards = nRanksTable[c] + nRanksTable[d] + nRanksTable[h] + nRanksTable[s];
 
-    // if there are five or fewer cards, we just evaluate the high,
-    // fix the wheel, and take the complement
-    switch (size()) {
-        case 0:
-        case 1:
-        case 2:
-        case 3:
-        case 4:
-            high = evaluateHighRanks();
-            break;
+    if (ncards <= FULL_HAND_SIZE) {
+        const int* table = lowball2to7Table();
+        if (ncards != nRanksTable[rankmask])
+            return PokerEvaluation(table[LOW27_PAIRED + rankMultisetIndex(c, d, h, s)]);
+        if (nRanksTable[c] == FULL_HAND_SIZE || nRanksTable[d] == FULL_HAND_SIZE ||
+            nRanksTable[h] == FULL_HAND_SIZE || nRanksTable[s] == FULL_HAND_SIZE)
+            return PokerEvaluation(table[LOW27_FLUSH + rankmask]);
+        return PokerEvaluation(table[LOW27_RANKS + rankmask]);
+    }
 
-        case 5:
-            high = evaluateHighRanks();
-            high.fixWheel2to7(rankMask());
-            break;
+    // this is a slow way to handle the general case.
+    // TODO: specialize the code for the 6 and 7 card cases.
+    vector<Card> cards = this->cards();
+    combinations combo(size(), FULL_HAND_SIZE);
+    PokerEvaluation best;
+    do {
+        CardSet candidate;
+        for (size_t i = 0; i < static_cast<size_t>(FULL_HAND_SIZE); i++)
+            candidate.insert(cards[combo[i]]);
+        PokerEvaluation e = candidate.evaluateLow2to7();
+        if (e > best)
+            best = e;
+    } while (combo.next());
+    return best;
+}
 
-        default:
-            // this is a slow way to handle the general case.
-            // TODO: specialize the code for the 6 and 7 card cases.
-            vector<Card> cards = this->cards();
-            combinations combo(size(), FULL_HAND_SIZE);
-            PokerEvaluation best;
-            do {
-                CardSet candidate;
-                for (size_t i = 0; i < static_cast<size_t>(FULL_HAND_SIZE); i++)
-                    candidate.insert(cards[combo[i]]);
-                PokerEvaluation e = candidate.evaluateRanksLow2to7();
-                if (e > best)
-                    best = e;
-            } while (combo.next());
-            return best;
+PokerEvaluation CardSet::evaluateRanksLow2to7() const
+{
+    int c = C();
+    int d = D();
+    int h = H();
+    int s = S();
+    int rankmask = c | d | h | s;
+    int ncards = nRanksTable[c] + nRanksTable[d] + nRanksTable[h] + nRanksTable[s];
+
+    if (ncards <= FULL_HAND_SIZE) {
+        const int* table = lowball2to7Table();
+        if (ncards != nRanksTable[rankmask])
+            return PokerEvaluation(table[LOW27_PAIRED + rankMultisetIndex(c, d, h, s)]);
+        return PokerEvaluation(table[LOW27_RANKS + rankmask]);
     }
 
-    high.flip();
-    return high;
+    // this is a slow way to handle the general case.
+    // TODO: specialize the code for the 6 and 7 card cases.
+    vector<Card> cards = this->cards();
+    combinations combo(size(), FULL_HAND_SIZE);
+    PokerEvaluation best;
+    do {
+        CardSet candidate;
+        for (size_t i = 0; i < static_cast<size_t>(FULL_HAND_SIZE); i++)
+            candidate.insert(cards[combo[i]]);
+        PokerEvaluation e = candidate.evaluateRanksLow2to7();
+        if (e > best)
+            best = e;
+    } while (combo.next());
+    return best;
 }
 
 // This one is not fully optimized
@@ -958,7 +1010,35 @@ PokerEvaluation CardSet::evaluateSuitsLow2to7() const
     return high;
 }
 
-// This one is not fully optimized
+// The best low of any five cards from a hand of up to seven, the five
+// card evaluation can not go wrong picking which pairs to play.
+PokerEvaluation CardSet::bestFiveLowA5(uint64_t mask)
+{
+    CardSet cards(mask);
+    if (cards.size() <= FULL_HAND_SIZE)
+        return cards.evaluateLowA5Paired();
+
+    PokerEvaluation best;
+    for (uint64_t rest = mask; rest; rest &= rest - 1)
+    {
+        PokerEvaluation e = bestFiveLowA5(mask ^ (rest & (~rest + 1)));
+        if (e > best)
+            best = e;
+    }
+    return best;
+}
+
+const int* CardSet::lowA5Table()
+{
+    static const vector<int> table = []() {
+        vector<int> ret(MultisetIndex::instance().size(), 0);
+        for (uint64_t mask : MultisetIndex::multisets(LOW_TABLE_CARDS))
+            ret[rankMultisetIndex(mask)] = bestFiveLowA5(mask).code();
+        return ret;
+    }();
+    return table.data();
+}
+
 PokerEvaluation CardSet::evaluateLowA5() const
 {
     // PokerEvaluation::generateLowballLookupA5();
@@ -967,7 +1047,6 @@ PokerEvaluation CardSet::evaluateLowA5() const
     // the rank masks and then fill accordingly.  We
     // also have to shift the rank mask according to the
     // the fact that the ace swings low
-    // this could probably be much faster
 
     int c = C();
     int d = D();
@@ -987,9 +1066,34 @@ PokerEvaluation CardSet::evaluateLowA5() const
         ret.flip();
         return ret;
     }
+
+    // paired hands of up to seven cards, which covers razz, come from
+    // the rank multiset table
+    if (ncards <= LOW_TABLE_CARDS)
+        return PokerEvaluation(lowA5Table()[rankMultisetIndex(c, d, h, s)]);
+
+    return evaluateLowA5Paired();
+}
+
+PokerEvaluation CardSet::evaluateLowA5Paired() const
+{
+    int c = C();
+    int d = D();
+    int h = H();
+    int s = S();
+    int rankmask = c | d | h | s;
+
+    int ncards = nRanksTable[c] + nRanksTable[d] + nRanksTable[h] + nRanksTable[s];
+    int nranks = nRanksTable[rankmask];
+
+    if (nranks >= FULL_HAND_SIZE || ncards == nranks) {
+        PokerEvaluation ret((NO_PAIR << VSHIFT) ^ lowballA5Ranks[rankmask] ^ ACE_LOW_BIT);
+        ret.flip();
+        return ret;
+    }
     // another easy case
     // *) we have five or fewer cards
-    else if (ncards <= FULL_HAND_SIZE) {
+    if (ncards <= FULL_HAND_SIZE) {
         PokerEvaluation ret = evaluatePairing();
         ret.playAceLow();
         ret.flip();
@@ -1132,7 +1236,33 @@ static inline bool badugiless(int c1, int c2)
  * traversals will be done.  Suits of size zero can be ruled out and
  * those with size one can be ruled in.
  */
+namespace
+{
+const size_t BADUGI_CARDS = 4;
+}  // namespace
+
+// Every four card hand, 52c4 = 270725 entries, built on first use.
+const int* CardSet::badugiTable()
+{
+    static const vector<int> table = []() {
+        size_t n = static_cast<size_t>(choose(STANDARD_DECK_SIZE, BADUGI_CARDS));
+        vector<int> ret(n, 0);
+        for (size_t i = 0; i < n; i++)
+            ret[i] = fromColex(BADUGI_CARDS, i).evaluateBadugiSearch().code();
+        return ret;
+    }();
+    return table.data();
+}
+
 PokerEvaluation CardSet::evaluateBadugi() const
+{
+    // the usual four card hand is a table lookup
+    if (size() == BADUGI_CARDS)
+        return PokerEvaluation(badugiTable()[colex()]);
+    return evaluateBadugiSearch();
+}
+
+PokerEvaluation CardSet::evaluateBadugiSearch() const
 {
     // get our ranks orgainzed in lowball order by suit
     std::array<int, 4> suits = {
@@ -1341,15 +1471,37 @@ CardSet pokerstove::canonizeToBoard(const CardSet& board, const CardSet& hand)
 #undef RMASK
 #undef SUITMASK
 
+namespace
+{
+// choose(n, k) for n < STANDARD_DECK_SIZE, as integers for colex()
+struct ColexTable
+{
+    size_t choose[STANDARD_DECK_SIZE][STANDARD_DECK_SIZE + 1];
+
+    ColexTable()
+    {
+        for (size_t n = 0; n < STANDARD_DECK_SIZE; n++)
+            for (size_t k = 0; k <= STANDARD_DECK_SIZE; k++)
+                choose[n][k] = static_cast<size_t>(pokerstove::choose(static_cast<int>(n),
+                                                                      static_cast<int>(k)));
+    }
+};
+
+const ColexTable& colexTable()
+{
+    static const ColexTable table;
+    return table;
+}
+}  // namespace
+
 size_t CardSet::colex() const
 {
-    vector<Card> cards = this->cards();
+    const ColexTable& table = colexTable();
+    uint64_t mask = _cardmask;
     size_t value = 0;
-    for (size_t i = 0; i < cards.size(); i++) {
-        size_t code = cards[i].code();
-        if (code >= i + 1) {
-            value += static_cast<size_t>(choose(code, i + 1));
-        }
+    for (size_t i = 1; mask; i++) {
+        value += table.choose[lastbit(mask)][i];
+        mask &= mask - 1;
     }
     return value;
 }
@@ -199,6 +199,13 @@ protected:
     bool isTripped() const;             //!< returns true if trips
 
 private:
+    PokerEvaluation evaluateLowA5Paired() const;   //!< A-5 low the long way, for paired hands
+    static const int* lowA5Table();                 //!< see evaluateLowA5
+    static PokerEvaluation bestFiveLowA5(uint64_t mask);
+    static const int* lowball2to7Table();           //!< see evaluateLow2to7
+    PokerEvaluation evaluateBadugiSearch() const;   //!< badugi the long way
+    static const int* badugiTable();                //!< see evaluateBadugi
+
     //!< bit mask of cards in "canonical" order. [2c,3c ... Ac,Ad ... Ah ... Qs,Ks,As]
     uint64_t _cardmask;
 };
@@ -1,4 +1,5 @@
 #include "CardSet.h"
+#include "PokerEvaluation.h"
 #include <gtest/gtest.h>
 
 using namespace pokerstove;
@@ -125,3 +126,44 @@ TEST(CardSetTest, fromColex)
     const CardSet result2 = CardSet::fromColex(4, 0);
     EXPECT_EQ(result2,  fourCardZero);
 }
+
+TEST(CardSetTest, evaluateLowA5Paired)
+{
+    // seven card razz hands, the table result is the best five card low
+    const char* hands[] = {"AcAd2c2d3c3d4c", "KcKdKhKsQcQdQh", "Ac2c3c4c4d4h4s",
+                           "5c5d5h6c6d7c8c", "AcAdAhAs2c2d2h", "9c9dTcTdJcJdQc"};
+    for (const char* h : hands)
+    {
+        CardSet hand(h);
+        std::vector<CardSet> cards = hand.cardSets();
+        PokerEvaluation best;
+        for (size_t skip1 = 0; skip1 < cards.size(); skip1++)
+            for (size_t skip2 = skip1 + 1; skip2 < cards.size(); skip2++)
+            {
+                CardSet five = hand;
+                five ^= cards[skip1];
+                five ^= cards[skip2];
+                best = std::max(best, five.evaluateLowA5());
+            }
+        EXPECT_EQ(best.code(), hand.evaluateLowA5().code()) << h;
+    }
+
+    // a pair is worse than any unpaired low
+    EXPECT_GT(CardSet("KcQdJhTs9c").evaluateLowA5(),
+              CardSet("AcAd2h3s4c").evaluateLowA5());
+}
+
+TEST(CardSetTest, evaluateBadugi)
+{
+    // from best to worst, four card hands come from the table and the
+    // three card hand from the search
+    const char* hands[] = {"Ac2d3h4s", "Ac2d3h5s", "Kc2d3h4s", "Ac2d3h", "Ac2c3h4s",
+                           "AcAdAhAs"};
+    for (size_t i = 1; i < sizeof(hands) / sizeof(hands[0]); i++)
+        EXPECT_GT(CardSet(hands[i - 1]).evaluateBadugi(), CardSet(hands[i]).evaluateBadugi())
+            << hands[i - 1] << " " << hands[i];
+
+    // a four card hand with a three card badugi is the three card badugi
+    EXPECT_EQ(CardSet("Ac2d3h").evaluateBadugi().code(),
+              CardSet("Ac2d3h3d").evaluateBadugi().code());
+}
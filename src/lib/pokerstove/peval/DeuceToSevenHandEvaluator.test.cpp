@@ -32,3 +32,28 @@ TEST(DeuceToSevenEval, AceHigh)
     EXPECT_GT(h3, h4);
 
 }
+
+TEST(DeuceToSevenEval, Ordering)
+{
+    DeuceToSevenHandEvaluator eval;
+    // from best to worst
+    const char* hands[] = {"2c3d4h5s7c", "2c3d4h6s7c", "3c4d5h6s8c", "2c3d4h5sAc",
+                           "2c2d3h4s5c", "2c2d3h3s4c", "2c2d2h3s4c", "3c4d5h6s7c",
+                           "2c3c4c5c7c", "2c2d2h3s3c", "2c2d2h2s3c"};
+    for (size_t i = 1; i < sizeof(hands) / sizeof(hands[0]); i++)
+    {
+        CardSet better(hands[i - 1]);
+        CardSet worse(hands[i]);
+        EXPECT_GT(eval.evaluate(better).eval(), eval.evaluate(worse).eval())
+            << hands[i - 1] << " " << hands[i];
+    }
+
+    // the ranks only evaluation ignores the flush
+    CardSet flush("2c3c4c5c7c");
+    EXPECT_EQ(CardSet("2c3d4h5s7c").evaluateLow2to7().code(),
+              flush.evaluateRanksLow2to7().code());
+
+    // a sixth card can only help
+    EXPECT_EQ(CardSet("2c3d4h5s7c").evaluateLow2to7().code(),
+              CardSet("2c3d4h5s7cKd").evaluateLow2to7().code());
+}
@@ -0,0 +1,50 @@
+/**
+ * Copyright (c) 2012 Andrew Prock. All rights reserved.
+ */
+#include "OmahaEightHandEvaluator.h"
+
+#include <vector>
+
+using namespace std;
+
+namespace pokerstove
+{
+
+namespace
+{
+// the inverse of OmahaEightHandEvaluator::lowBits
+int lowRanks(int bits)
+{
+    return (bits & 0x7F) | ((bits & 0x80) << 5);
+}
+
+vector<int> buildLowTable()
+{
+    const int n = OmahaEightHandEvaluator::NUM_LOW_MASKS;
+    vector<int> table(n * n, 0);
+    for (int b = 0; b < n; b++)
+    {
+        int bmask = flipAce(lowRanks(b));
+        if (nRanksTable[bmask] < 3)
+            continue;
+        for (int h = 0; h < n; h++)
+        {
+            int hmask = flipAce(lowRanks(h));
+            if (nRanksTable[hmask] != 2)
+                continue;
+            CardSet ranks(static_cast<uint64_t>(
+                unflipAce(bottomRanks(bottomRanks(bmask & (~hmask), 3) | hmask, 5))));
+            table[b * n + h] = ranks.evaluate8LowA5().code();
+        }
+    }
+    return table;
+}
+}  // namespace
+
+const int* OmahaEightHandEvaluator::lowTable()
+{
+    static const vector<int> table = buildLowTable();
+    return table.data();
+}
+
+}  // namespace pokerstove
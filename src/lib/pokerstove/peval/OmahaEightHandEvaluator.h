@@ -5,6 +5,7 @@
 #define PEVAL_OMAHAEIGHTHANDEVALUATOR_H_
 
 #include "Holdem.h"
+#include "OmahaSubsets.h"
 #include "PokerEvaluationTables.h"
 #include "PokerHandEvaluator.h"
 #include <pokerstove/util/combinations.h>
@@ -63,76 +64,17 @@ public:
 
     virtual PokerHandEvaluation evaluateHand(const CardSet& hand, const CardSet& board) const
     {
-        PokerEvaluation eval[2];
-
-        // generate the possible sub hands, player hand candidates are all
-        // 4c2 combinations of hands cards,
-        // board candidates are all Nc3 board candidates, where N is the size
-        // of the board.
-        // If we have 0 cards, that is one case (no board). The case of 1 and
-        // two card boards is also supported for various test cases and outliers.
-        double combos = choose(board.size(), 3);
-        if (combos == 0) combos = 1;
-
-        std::vector<CardSet> board_candidates(static_cast<size_t>(combos));
-        std::vector<CardSet> hand_candidates(6);
-        fillHands(hand_candidates, hand);
-        fillBoards(board_candidates, board);
-
-        for (size_t i = 0; i < hand_candidates.size(); i++)
-        {
-            for (size_t j = 0; j < board_candidates.size(); j++)
-            {
-                PokerEvaluation e =
-                    CardSet(hand_candidates[i] | board_candidates[j]).evaluateHigh();
-                if (e > eval[0])
-                    eval[0] = e;
-            }
-        }
-
-        // evaluate the low using brec's technique, see:
-        // http://groups.google.com/group/rec.gambling.poker/msg/e8a3a7698d51f04a?dmode=source
-        //
-        // Nominally, it takes 60 evaluations to find a player's Omaha-8 low -- 4C2=6
-        // sets of 2 hole cards times 5C3=10 sets of 3 board cards.  However, each of
-        // the 6 sets of hole cards can be evaluated in one multi-step operation as
-        // follows:
-        //
-        //     Let H be a bit vector (typically an integer variable) of the ranks of
-        // the two hole cards; H has 1 or 2 bits set;
-        //     Let B be a bit vector of the ranks of the five board cards; B has 2 to 5
-        // bits set
-        //     Let L3[v] be a bit vector of the lowest (up to) 3 bits set in v; L3[v]
-        // can be obtained by table lookup;
-        //     Let L5[v] be a bit vector of the lowest 5 bits set in v, or a special
-        // "no low" value to indicate that v has fewer than 5 bits set or that not all
-        // bits in v represent ranks of 8 or lower;  L5[v] can be obtained by table
-        // lookup.
-        //
-        // Then the low value, represented as a bit vector of ranks, is
-        //     L5[L3[B & (~H)] | H]
-        // where &, ~, and | represent bitwise AND, NOT, and OR respectively.  This
-        // represents the operation of finding the lowest three board ranks not present
-        // in the hole cards, and adding the hole cards to make the 5-card low hand.
-
-        int bmask = flipAce(board.rankMask() & 0x107F);
-        if (nRanksTable[bmask] >= 3)
-        {
-            for (size_t i = 0; i < hand_candidates.size(); i++)
-            {
-                int hmask = flipAce(hand_candidates[i].rankMask() & 0x107F);
-                if (nRanksTable[hmask] < 2)
-                    continue;
-                CardSet lowRanks(unflipAce(bottomRanks(bottomRanks(bmask & (~hmask), 3) | hmask, 5)));
-                PokerEvaluation e = lowRanks.evaluate8LowA5();
-                if (e > eval[1])
-                {
-                    eval[1] = e;
-                }
-            }
-        }
-
-        return PokerHandEvaluation(eval[0], eval[1]);
+        // the two card pieces of the hand and the three card pieces of
+        // the board are built once and shared by both halves.  Boards of
+        // fewer than three cards are used whole, which supports the no
+        // board case and various test cases and outliers.
+        uint64_t hands[6];
+        uint64_t boards[10];
+        size_t nhands = omahaHandPairs<NUM_OMAHA_POCKET>(hand, hands);
+        size_t nboards = omahaBoardTriples(board, boards);
+
+        return PokerHandEvaluation(omahaBestHigh(hands, nhands, boards, nboards),
+                                   bestLow(hands, nhands, board));
     }
 
     /**
@@ -141,92 +83,64 @@ public:
      */
     PokerEvaluation evaluateTwoCardLow(const CardSet& twocard, const CardSet& board) const
     {
-        int bmask = flipAce(board.rankMask() & 0x107F);
-        int hmask = flipAce(twocard.rankMask() & 0x107F);
-        if (nRanksTable[hmask] < 2)
-            return PokerEvaluation();
-        CardSet lowRanks(unflipAce(
-            bottomRanks(bottomRanks(bmask & (~hmask), 3) | hmask, 5)));
-        return lowRanks.evaluate8LowA5();
+        const int* row = lowTable() + lowBits(board.rankMask()) * NUM_LOW_MASKS;
+        return PokerEvaluation(row[lowBits(twocard.rankMask())]);
     }
 
     PokerEvaluation evaluateLow(const CardSet& hand, const CardSet& board) const
     {
-        PokerEvaluation eval;
-        std::vector<CardSet> hand_candidates(6);
-        fillHands(hand_candidates, hand);
-        int bmask = flipAce(board.rankMask() & 0x107F);
-        if (nRanksTable[bmask] >= 3)
-        {
-            for (size_t i = 0; i < hand_candidates.size(); i++)
-            {
-                int hmask = flipAce(hand_candidates[i].rankMask() & 0x107F);
-                if (nRanksTable[hmask] < 2)
-                    continue;
-                CardSet lowRanks(unflipAce(bottomRanks(bottomRanks(bmask & (~hmask), 3) | hmask, 5)));
-                PokerEvaluation e = lowRanks.evaluate8LowA5();
-                if (e > eval)
-                {
-                    eval = e;
-                }
-            }
-        }
-        return eval;
+        uint64_t hands[6];
+        size_t nhands = omahaHandPairs<NUM_OMAHA_POCKET>(hand, hands);
+        return bestLow(hands, nhands, board);
     }
 
-    void fillHands(std::vector<CardSet>& candidates, const CardSet& cards) const
-    {
-        std::vector<CardSet> clist = cards.cardSets();
-        candidates[0] = (clist[0] | clist[1]);
-        candidates[1] = (clist[0] | clist[2]);
-        candidates[2] = (clist[0] | clist[3]);
-        candidates[3] = (clist[1] | clist[2]);
-        candidates[4] = (clist[1] | clist[3]);
-        candidates[5] = (clist[2] | clist[3]);
-    }
+    /**
+     * The best qualifying 8 low for each board and two card hand, as a
+     * PokerEvaluation code, or 0 for no low.  Indexed by
+     * lowBits(board) * NUM_LOW_MASKS + lowBits(hand).  Only the ranks
+     * eight and below matter to the low, so the table is 256x256 and
+     * built on first use.
+     *
+     * The entries are found using brec's technique, see:
+     * http://groups.google.com/group/rec.gambling.poker/msg/e8a3a7698d51f04a?dmode=source
+     *
+     * Let H be the ranks of the two hole cards and B the ranks of the
+     * board, the low is the lowest three ranks of B which are not in H,
+     * added to H, provided that makes five ranks.  The table does this
+     * once for every (B, H) so that evaluation is one lookup per pair of
+     * hole cards.
+     */
+    static const int NUM_LOW_MASKS = 256;
+    static const int* lowTable();
 
-    void fillBoards(std::vector<CardSet>& candidates, const CardSet& cards) const
+    /**
+     * the ranks eight and below of a rank mask, packed into 8 bits with
+     * the ace in the top bit
+     */
+    static int lowBits(int rankMask)
     {
-        std::vector<CardSet> clist = cards.cardSets();
-        switch (clist.size())
-        {
-            case 5:
-                candidates[4] = (clist[0] | clist[1] | clist[4]);
-                candidates[5] = (clist[0] | clist[2] | clist[4]);
-                candidates[6] = (clist[0] | clist[3] | clist[4]);
-                candidates[7] = (clist[1] | clist[2] | clist[4]);
-                candidates[8] = (clist[1] | clist[3] | clist[4]);
-                candidates[9] = (clist[2] | clist[3] | clist[4]);
-                // fall through
-
-            case 4:
-                candidates[1] = (clist[0] | clist[1] | clist[3]);
-                candidates[2] = (clist[0] | clist[2] | clist[3]);
-                candidates[3] = (clist[1] | clist[2] | clist[3]);
-                // fall through
-
-            case 3:
-                candidates[0] = clist[0] | clist[1] | clist[2];
-                break;
-
-            case 2:
-                candidates[0] = clist[0] | clist[1];
-                break;
-
-            case 1:
-                candidates[0] = clist[0];
-                break;
-
-            case 0:
-                candidates[0] = CardSet();
-                break;
-
-        }
+        return (rankMask & 0x7F) | ((rankMask >> 5) & 0x80);
     }
 
     virtual size_t handSize() const { return NUM_OMAHA_POCKET; }
     virtual size_t boardSize() const { return BOARD_SIZE; }
     virtual size_t evaluationSize() const { return 2; }
+
+    /**
+     * the best low of any of the two card hands with the board
+     */
+    static PokerEvaluation bestLow(const uint64_t* hands, size_t nhands, const CardSet& board)
+    {
+        const int* row = lowTable() + lowBits(board.rankMask()) * NUM_LOW_MASKS;
+        int best = 0;
+        for (size_t i = 0; i < nhands; i++)
+        {
+            int code = row[lowBits(CardSet(hands[i]).rankMask())];
+            if (code > best)
+                best = code;
+        }
+        return PokerEvaluation(best);
+    }
 };
 
 }  // namespace pokerstove
@@ -1,6 +1,8 @@
 #include "OmahaEightHandEvaluator.h"
+#include "Card.h"
 #include <gtest/gtest.h>
 #include <iostream>
+#include <random>
 
 using namespace pokerstove;
 using namespace std;
@@ -82,4 +84,42 @@ TEST(OmahaEightHandEvaluator, ThreeQuartered)
     CardSet c4("4c3cKhQd");
     CardSet board2("Ac2d6cKcJs");
     EXPECT_EQ(eval.evaluateEquity(c3, c4, board2), 0.25);
-}
\ No newline at end of file
+}
+TEST(OmahaEightHandEvaluator, MatchesBruteForce)
+{
+    OmahaEightHandEvaluator eval;
+    mt19937 rng(38);
+    uniform_int_distribution<int> card(0, STANDARD_DECK_SIZE - 1);
+    for (int trial = 0; trial < 2000; trial++)
+    {
+        CardSet dealt;
+        while (dealt.size() < 9)
+            dealt.insert(Card(static_cast<uint8_t>(card(rng))));
+        vector<Card> cards = dealt.cards();
+        CardSet hand, board;
+        for (size_t i = 0; i < 4; i++)
+            hand.insert(cards[i]);
+        for (size_t i = 4; i < 9; i++)
+            board.insert(cards[i]);
+
+        // every two cards from the hand with every three from the board
+        PokerEvaluation high, low;
+        vector<CardSet> hands = hand.cardSets();
+        vector<CardSet> boards = board.cardSets();
+        for (size_t h1 = 0; h1 < 4; h1++)
+            for (size_t h2 = h1 + 1; h2 < 4; h2++)
+                for (size_t b1 = 0; b1 < 5; b1++)
+                    for (size_t b2 = b1 + 1; b2 < 5; b2++)
+                        for (size_t b3 = b2 + 1; b3 < 5; b3++)
+                        {
+                            CardSet five = hands[h1] | hands[h2] | boards[b1] |
+                                           boards[b2] | boards[b3];
+                            high = max(high, five.evaluateHigh());
+                            low = max(low, five.evaluate8LowA5());
+                        }
+
+        PokerHandEvaluation e = eval.evaluateHand(hand, board);
+        EXPECT_EQ(high.code(), e.high().code()) << hand.str() << " " << board.str();
+        EXPECT_EQ(low.code(), e.low().code()) << hand.str() << " " << board.str();
+    }
+}
@@ -0,0 +1,23 @@
+/**
+ * Copyright (c) 2012 Andrew Prock. All rights reserved.
+ */
+#include "OmahaSubsets.h"
+
+namespace pokerstove
+{
+
+const uint8_t OMAHA_PAIR_INDEX[15][2] = {
+    {0, 1},
+    {0, 2}, {1, 2},
+    {0, 3}, {1, 3}, {2, 3},
+    {0, 4}, {1, 4}, {2, 4}, {3, 4},
+    {0, 5}, {1, 5}, {2, 5}, {3, 5}, {4, 5},
+};
+
+const uint8_t OMAHA_TRIPLE_INDEX[10][3] = {
+    {0, 1, 2},
+    {0, 1, 3}, {0, 2, 3}, {1, 2, 3},
+    {0, 1, 4}, {0, 2, 4}, {1, 2, 4}, {0, 3, 4}, {1, 3, 4}, {2, 3, 4},
+};
+
+}  // namespace pokerstove
@@ -0,0 +1,97 @@
+/**
+ * Copyright (c) 2012 Andrew Prock. All rights reserved.
+ */
+#ifndef PEVAL_OMAHASUBSETS_H_
+#define PEVAL_OMAHASUBSETS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include "CardSet.h"
+#include "PokerEvaluation.h"
+
+namespace pokerstove
+{
+/**
+ * Card index pairs and triples in colex order, so that the first
+ * choose(n,2) pairs (or choose(n,3) triples) are exactly the subsets of
+ * the first n cards.  One table serves every hand and board size.
+ */
+extern const uint8_t OMAHA_PAIR_INDEX[15][2];
+extern const uint8_t OMAHA_TRIPLE_INDEX[10][3];
+
+/**
+ * Split a mask into at most max single card masks, lowest first.
+ */
+inline size_t omahaSplitCards(uint64_t mask, uint64_t* cards, size_t max)
+{
+    size_t n = 0;
+    while (mask && n < max)
+    {
+        cards[n++] = mask & (~mask + 1);
+        mask &= mask - 1;
+    }
+    return n;
+}
+
+/**
+ * All pairs of the (up to POCKET) hand cards, a hand of fewer than two
+ * cards is its own only candidate.  pairs must hold choose(POCKET,2).
+ */
+template <size_t POCKET>
+size_t omahaHandPairs(const CardSet& hand, uint64_t* pairs)
+{
+    uint64_t cards[POCKET];
+    size_t n = omahaSplitCards(hand.mask(), cards, POCKET);
+    if (n < 2)
+    {
+        pairs[0] = hand.mask();
+        return 1;
+    }
+    size_t npairs = n * (n - 1) / 2;
+    for (size_t i = 0; i < npairs; i++)
+        pairs[i] = cards[OMAHA_PAIR_INDEX[i][0]] | cards[OMAHA_PAIR_INDEX[i][1]];
+    return npairs;
+}
+
+/**
+ * All three card subsets of the (up to five card) board, boards of fewer
+ * than three cards are used whole, which supports the no board case and
+ * various test cases and outliers.  triples must hold ten.
+ */
+inline size_t omahaBoardTriples(const CardSet& board, uint64_t* triples)
+{
+    uint64_t cards[5];
+    size_t n = omahaSplitCards(board.mask(), cards, 5);
+    if (n < 3)
+    {
+        triples[0] = board.mask();
+        return 1;
+    }
+    size_t ntriples = n * (n - 1) * (n - 2) / 6;
+    for (size_t i = 0; i < ntriples; i++)
+        triples[i] = cards[OMAHA_TRIPLE_INDEX[i][0]] |
+                     cards[OMAHA_TRIPLE_INDEX[i][1]] |
+                     cards[OMAHA_TRIPLE_INDEX[i][2]];
+    return ntriples;
+}
+
+/**
+ * The best high hand made of one of the pairs and one of the triples.
+ */
+inline PokerEvaluation omahaBestHigh(const uint64_t* pairs, size_t npairs,
+                                     const uint64_t* triples, size_t ntriples)
+{
+    PokerEvaluation high;
+    for (size_t i = 0; i < npairs; i++)
+        for (size_t j = 0; j < ntriples; j++)
+        {
+            PokerEvaluation e = CardSet(pairs[i] | triples[j]).evaluateHigh();
+            if (e > high)
+                high = e;
+        }
+    return high;
+}
+
+}  // namespace pokerstove
+
+#endif  // PEVAL_OMAHASUBSETS_H_
@@ -203,7 +203,7 @@ int PokerEvaluation::showdownCode() const
     }
 }
 
-int PokerEvaluation::type() const { return _evalcode >> VSHIFT; }
+int PokerEvaluation::type() const { return (_evalcode >> VSHIFT) & 0x0F; }
 
 int PokerEvaluation::kickerBits() const { return _evalcode & KICKER_MASK; }
 Rank PokerEvaluation::majorRank() const { return Rank((_evalcode >> MAJOR_SHIFT) & 0x0F); }
@@ -412,7 +412,7 @@ string PokerEvaluation::toStringCannon() const
     string botr;
     string kick;
 
-    int val = n >> 24;
+    int val = type();
     switch (val)
     {
         case NO_PAIR:
@@ -518,7 +518,7 @@ string PokerEvaluation::toStringPretty() const
     string botr;
     string kick;
 
-    int val = n >> 24;
+    int val = type();
     switch (val)
     {
         case NO_PAIR:
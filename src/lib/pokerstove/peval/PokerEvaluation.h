@@ -34,6 +34,7 @@ namespace pokerstove
   const int MAX_EVAL_HAND_SIZE    =  7;
 
   const int VSHIFT = 24;
+  const int ORDER_SHIFT = 28;
   const int MAJOR_SHIFT = 20;
   const int MINOR_SHIFT = 16;
   const int ACE_LOW_BIT = 0x01 << Rank::NUM_RANK;
@@ -174,8 +175,9 @@ namespace pokerstove
     /**
      * the integer code is organized bitwise as:
      *  21 0987654 32109876 54321098 76543210
-     *        TTTT MMMMmmmm BBAkkkkk kkkkkkkk
+     *     OO TTTT MMMMmmmm BBAkkkkk kkkkkkkk
      *
+     * O = order bits, zero unless a game ranks the types differently
      * T = type bits [0,12] (pair, trips, flush, etc...)
      * M = major rank
      * m = minor rank
@@ -193,6 +195,11 @@ namespace pokerstove
      * major/minor rank codes is shifted as
      * well.
      *
+     * Games which change the order of the hand types,
+     * like short deck where a flush beats a full house,
+     * set the order bits above the type so the codes
+     * still compare in the right order.
+     *
      * In the case that a hand represents a "lowball"
      * hand the entire bitstring will be flipped so
      * the the ordering is reversed.  That will
@@ -16,6 +16,13 @@ PokerHandEvaluator::PokerHandEvaluator()
 
 PokerHandEvaluator::~PokerHandEvaluator() {}
 
+CardSet PokerHandEvaluator::deck() const
+{
+    CardSet cards;
+    cards.fill();
+    return cards;
+}
+
 static double INV_LUT[] = {0,
                            1/1.0, 1/2.0, 1/3.0, 1/4.0, 1/5.0,
                            1/6.0, 1/7.0, 1/8.0, 1/9.0, 1/10.0};
@@ -32,7 +39,7 @@ void display(const vector<CardSet>& hands, const CardSet& board, vector<EquityRe
     cout << endl;
 }
 
-void PokerHandEvaluator::evaluateShowdown(const vector<CardSet>& hands,
+int PokerHandEvaluator::evaluateShowdown(const vector<CardSet>& hands,
                                           const CardSet& board,
                                           vector<PokerHandEvaluation>& evals,
                                           vector<EquityResult>& result,
@@ -59,6 +66,7 @@ void PokerHandEvaluator::evaluateShowdown(const vector<CardSet>& hands,
     }
 
     // award share(s)
+    int flags = (nevals == 2) ? SHOWDOWN_SPLIT : 0;
     for (size_t e = 0; e < nevals; e++)
     {
         // find the best eval, and adjust shares if there are ties
@@ -87,12 +95,14 @@ void PokerHandEvaluator::evaluateShowdown(const vector<CardSet>& hands,
         // award shares to those who tie
         else
         {
+            flags |= SHOWDOWN_TIE;
             for (size_t i = 0; i < hsize; i++)
                 if (evals[i].eval(e) == maxeval)
                     result[i].tieShares += INV_LUT[shares * nevals] * weight;
         }
     }
     // display (hands, board, result);
+    return flags;
 }
 
 double PokerHandEvaluator::evaluateEquity(
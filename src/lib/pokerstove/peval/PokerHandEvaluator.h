@@ -62,7 +62,7 @@ struct EquityResult
             shares += result.shares();
         }
         for (EquityResult& result : results) {
-            shares += result.equity = result.shares()/shares;
+            result.equity = result.shares()/shares;
         }
     }
 };
@@ -129,6 +129,7 @@ public:
     virtual size_t boardSize () const = 0;           //!< return the maximum size of the community cards
     virtual size_t evaluationSize () const = 0;      //!< return 1 for high only, 2 for high low
     virtual size_t numDraws () const { return 0; }   //!< return the maximum size of a players hand
+    virtual CardSet deck () const;                   //!< return the cards the game is played with
 
     virtual PokerEvaluation evaluateRanks (const CardSet & hand,
                                            const CardSet& board=CardSet(0)) const
@@ -175,8 +176,18 @@ public:
      * size as the result vector.  The hands vector is allowe to be larger
      * than that.  The board may or may not be used depending on how
      * evaluateHand is implemented.
+     *
+     * The return value describes the showdown, it is a combination of
+     * SHOWDOWN_TIE if any pot was tied, and SHOWDOWN_SPLIT if there was a
+     * low half to award.
      */
-    void evaluateShowdown(const std::vector<CardSet>& hands,
+    enum ShowdownFlags
+    {
+        SHOWDOWN_TIE   = 0x01,
+        SHOWDOWN_SPLIT = 0x02
+    };
+
+    int evaluateShowdown(const std::vector<CardSet>& hands,
                           const pokerstove::CardSet& board,
                           std::vector<PokerHandEvaluation>& evals,
                           std::vector<EquityResult>& result,
@@ -191,6 +202,11 @@ public:
                           const pokerstove::CardSet& c2,
                           const pokerstove::CardSet& board=CardSet());
 
+    /**
+     * the game id this evaluator was allocated with, "h", "o/8", etc.
+     */
+    const std::string& id() const { return _subclassID; }
+
 protected:
     PokerHandEvaluator();
 
@@ -18,3 +18,14 @@ TEST(PokerHandEvaluator, InvalidGame)
     EXPECT_EQ(nullptr, evaluator);
 }
 
+
+TEST(PokerHandEvaluator, BigOmaha)
+{
+    using namespace pokerstove;
+
+    EXPECT_EQ(5, PokerHandEvaluator::alloc("o5")->handSize());
+    EXPECT_EQ(1, PokerHandEvaluator::alloc("o5")->evaluationSize());
+    EXPECT_EQ(6, PokerHandEvaluator::alloc("o6")->handSize());
+    EXPECT_EQ(2, PokerHandEvaluator::alloc("O6/8")->evaluationSize());
+    EXPECT_EQ(nullptr, PokerHandEvaluator::alloc("o7"));
+}
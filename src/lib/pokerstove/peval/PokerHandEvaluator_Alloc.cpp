@@ -10,9 +10,11 @@
 #include "StudEightHandEvaluator.h"
 #include "OmahaHighHandEvaluator.h"
 #include "OmahaEightHandEvaluator.h"
+#include "BigOmahaHandEvaluator.h"
 #include "DeuceToSevenHandEvaluator.h"
 #include "DrawHighHandEvaluator.h"
 #include "BadugiHandEvaluator.h"
+#include "ShortDeckHandEvaluator.h"
 //#include "LowballA5HandEvaluator.h"
 //#include "ThreeCardPokerHandEvaluator.h"
 
@@ -35,38 +37,33 @@ std::shared_ptr<PokerHandEvaluator> PokerHandEvaluator::alloc (const string & in
       break;
 
     case 'k':		//     Kansas City lowball (2-7)
-      ret.reset (new UniversalHandEvaluator (1,5,0,0,0,&CardSet::evaluateLow2to7, NULL));
+      ret.reset (new StaticUniversalHandEvaluator<&CardSet::evaluateLow2to7> (1,5,0,0,0));
       break;
 
     case 'l':		//     lowball (A-5)
-      ret.reset (new UniversalHandEvaluator (1,5,0,0,0,&CardSet::evaluateLowA5, NULL));
+      ret.reset (new StaticUniversalHandEvaluator<&CardSet::evaluateLowA5> (1,5,0,0,0));
+      ret->useSuits (false);
       break;
 
     case '3':		//     three card poker
-      ret.reset (new UniversalHandEvaluator (1,3,0,0,0,&CardSet::evaluate3CP, NULL));
+      ret.reset (new StaticUniversalHandEvaluator<&CardSet::evaluate3CP> (1,3,0,0,0));
       break;
 
     case 'o':		//     omaha
-    {
-      auto ohigh = new UniversalHandEvaluator (4,4,3,5,2,&CardSet::evaluateHigh, NULL);
-      auto ohighlow8 = new UniversalHandEvaluator (4,4,3,5,2,&CardSet::evaluateHigh, NULL);
-      if (strid == "o6" || strid == "o5") {
-        ret.reset (new UniversalHandEvaluator (4,4,3,5,2,&CardSet::evaluateHigh, NULL));
-      } else if (strid == "o5/8" || strid == "o6/8") {
-        ret.reset (new UniversalHandEvaluator (4,4,3,5,2, &CardSet::evaluateHigh, &CardSet::evaluate8LowA5));
-      } else if (strid == "o") {
-        ret.reset (new OmahaHighHandEvaluator);
-      } else if (strid == "o/8") {
-        ret.reset (new OmahaEightHandEvaluator);
-      } else if (strid == "o8") {
-        ret.reset (new OmahaEightHandEvaluator);
-      } else if (strid == "omaha") {
+      if (strid == "o" || strid == "omaha") {
         ret.reset (new OmahaHighHandEvaluator);
-      } else if (strid == "omaha/8") {
+      } else if (strid == "o/8" || strid == "o8" || strid == "omaha/8") {
         ret.reset (new OmahaEightHandEvaluator);
+      } else if (strid == "o5") {
+        ret.reset (new Omaha5HighHandEvaluator);
+      } else if (strid == "o5/8") {
+        ret.reset (new Omaha5EightHandEvaluator);
+      } else if (strid == "o6") {
+        ret.reset (new Omaha6HighHandEvaluator);
+      } else if (strid == "o6/8") {
+        ret.reset (new Omaha6EightHandEvaluator);
       }
-    }
-    break;
+      break;
 
       //
       // For the draw games, we need to be able to evaluate 1 card to determine the
@@ -83,7 +80,7 @@ std::shared_ptr<PokerHandEvaluator> PokerHandEvaluator::alloc (const string & in
       break;
 
     case 'q':		//     stud high/low no qualifier
-      ret.reset (new UniversalHandEvaluator (1,7,0,0,0, &CardSet::evaluateHigh, &CardSet::evaluateLowA5));
+      ret.reset (new StaticUniversalHandEvaluator<&CardSet::evaluateHigh, &CardSet::evaluateLowA5> (1,7,0,0,0));
       break;
 
     case 'd':		//     draw high
@@ -98,7 +95,8 @@ std::shared_ptr<PokerHandEvaluator> PokerHandEvaluator::alloc (const string & in
       break;
 
     case 'T':		//     triple draw lowball (A-5)
-      ret.reset (new UniversalHandEvaluator (1,5,0,0,0,&CardSet::evaluateLowA5, NULL));
+      ret.reset (new StaticUniversalHandEvaluator<&CardSet::evaluateLowA5> (1,5,0,0,0));
+      ret->useSuits (false);
       break;
 
     case 'e':		//     stud/8
@@ -106,6 +104,10 @@ std::shared_ptr<PokerHandEvaluator> PokerHandEvaluator::alloc (const string & in
       ret.reset (new StudEightHandEvaluator);
       break;
 
+    case '6':		//     short deck (6+) hold'em
+      ret.reset (new ShortDeckHandEvaluator);
+      break;
+
     case 'b':		//     badugi
       //ret.reset (new UniversalHandEvaluator (0,52,0,0,0,&CardSet::evaluateBadugi,NULL));
       ret.reset (new BadugiHandEvaluator);
@@ -115,6 +117,8 @@ std::shared_ptr<PokerHandEvaluator> PokerHandEvaluator::alloc (const string & in
       return ret;
     }
 
+  if (!ret)
+    return ret;
   ret->_subclassID = strid;
 
   return ret;
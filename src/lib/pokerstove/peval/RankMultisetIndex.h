@@ -0,0 +1,120 @@
+/**
+ * Copyright (c) 2012 Andrew Prock. All rights reserved.
+ */
+#ifndef PEVAL_RANKMULTISETINDEX_H_
+#define PEVAL_RANKMULTISETINDEX_H_
+
+#include <cstdint>
+#include <vector>
+#include "Rank.h"
+#include "Suit.h"
+#include <pokerstove/util/lastbit.h>
+
+namespace pokerstove
+{
+/**
+ * Colex index of the rank multisets of hands of up to MAX_CARDS cards
+ * drawn from NUM_RANKS ranks, for evaluations which depend only on the
+ * ranks of a hand.  With the ranks sorted r[0] <= r[1] <= ..., the
+ * values r[i]+i are distinct, so the multiset ranks like a combination
+ * of them.  Indexes cover every size of multiset up to MAX_CARDS, each
+ * size after all the smaller ones.
+ */
+template <int NUM_RANKS, int MAX_CARDS>
+class RankMultisetIndex
+{
+public:
+    static const int NUM_VALUES = NUM_RANKS + MAX_CARDS;
+
+    RankMultisetIndex()
+    {
+        for (int n = 0; n < NUM_VALUES; n++)
+            for (int k = 0; k <= MAX_CARDS; k++)
+                _choose[n][k] = (k == 0) ? 1 : (n == 0) ? 0
+                              : _choose[n - 1][k - 1] + _choose[n - 1][k];
+        // the number of multisets of size k is choose(NUM_RANKS+k-1, k)
+        _offset[0] = 0;
+        for (int k = 0; k <= MAX_CARDS; k++)
+            _offset[k + 1] = _offset[k] + (k == 0 ? 1 : _choose[NUM_RANKS + k - 1][k]);
+    }
+
+    static const RankMultisetIndex& instance()
+    {
+        static const RankMultisetIndex index;
+        return index;
+    }
+
+    /**
+     * the number of multisets, one past the largest index
+     */
+    int size() const { return _offset[MAX_CARDS + 1]; }
+
+    /**
+     * the index of the first multiset of ncards cards, [0,MAX_CARDS+1]
+     */
+    int offset(int ncards) const { return _offset[ncards]; }
+
+    /**
+     * c, d, h, s are the NUM_RANKS bit rank masks of each suit of a hand
+     * of at most MAX_CARDS cards
+     */
+    int index(int c, int d, int h, int s) const
+    {
+        int rankmask = c | d | h | s;
+        int ret = 0;
+        int i = 0;
+        while (rankmask)
+        {
+            int r = lastbit(static_cast<uint32_t>(rankmask));
+            rankmask &= rankmask - 1;
+            int count = ((c >> r) & 1) + ((d >> r) & 1) + ((h >> r) & 1) + ((s >> r) & 1);
+            for (int k = 0; k < count; k++, i++)
+                ret += _choose[r + i][i + 1];
+        }
+        return _offset[i] + ret;
+    }
+
+    /**
+     * One hand for every multiset of ranks with at most four of a rank
+     * and at most maxCards cards, the k'th card of each rank goes in the
+     * k'th suit.  The ranks are the NUM_RANKS from lowRank up.
+     */
+    static std::vector<uint64_t> multisets(int maxCards, int lowRank = 0)
+    {
+        std::vector<uint64_t> ret;
+        int counts[NUM_RANKS] = {0};
+        int ncards = 0;
+        for (;;)
+        {
+            uint64_t mask = 0;
+            for (int r = 0; r < NUM_RANKS; r++)
+                for (int k = 0; k < counts[r]; k++)
+                    mask |= UINT64_C(1) << (lowRank + r + Rank::NUM_RANK * k);
+            ret.push_back(mask);
+
+            // advance the counts like an odometer, skipping over sets
+            // which are too large
+            int r = 0;
+            while (r < NUM_RANKS)
+            {
+                counts[r]++;
+                ncards++;
+                if (counts[r] <= static_cast<int>(Suit::NUM_SUIT) && ncards <= maxCards)
+                    break;
+                ncards -= counts[r];
+                counts[r] = 0;
+                r++;
+            }
+            if (r == NUM_RANKS)
+                return ret;
+        }
+    }
+
+private:
+    int _choose[NUM_VALUES][MAX_CARDS + 1];
+    int _offset[MAX_CARDS + 2];
+};
+
+}  // namespace pokerstove
+
+#endif  // PEVAL_RANKMULTISETINDEX_H_
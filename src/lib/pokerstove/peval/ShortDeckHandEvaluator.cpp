@@ -0,0 +1,142 @@
+/**
+ * Copyright (c) 2012 Andrew Prock. All rights reserved.
+ */
+#include "ShortDeckHandEvaluator.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+#include "PokerEvaluationTables.h"
+#include "RankMultisetIndex.h"
+
+using namespace std;
+
+namespace pokerstove
+{
+
+namespace
+{
+const int SUIT_RANKS = (1 << SHORT_DECK_RANKS) - 1;
+const int MAX_CARDS = MAX_EVAL_HAND_SIZE;
+
+// the A6789 straight, by short deck rank bits
+const int LOW_STRAIGHT = 0x10F;
+
+// the twos through fives of every suit
+const uint64_t LOW_CARDS = UINT64_C(0xF) | UINT64_C(0xF) << 13 |
+                           UINT64_C(0xF) << 26 | UINT64_C(0xF) << 39;
+
+typedef RankMultisetIndex<SHORT_DECK_RANKS, MAX_CARDS> MultisetIndex;
+
+// c, d, h, s are the nine bit rank masks of each suit
+int rankIndex(int c, int d, int h, int s)
+{
+    return MultisetIndex::instance().index(c, d, h, s);
+}
+
+// full houses, flushes, and quads move up past the types they beat in
+// short deck
+int reorder(int code)
+{
+    int key = 0;
+    switch (code >> VSHIFT)
+    {
+        case FULL_HOUSE:
+            key = 1;
+            break;
+        case FLUSH:
+            key = 2;
+            break;
+        case FOUR_OF_A_KIND:
+        case STRAIGHT_FLUSH:
+            key = 3;
+            break;
+    }
+    return code | key << ORDER_SHIFT;
+}
+
+// the hand with the given short deck rank bits in one suit
+uint64_t suitCards(int ranks, int suit)
+{
+    return static_cast<uint64_t>(ranks) << (Rank::Six().code() + Rank::NUM_RANK * suit);
+}
+
+vector<int> buildRankTable()
+{
+    vector<int> table(MultisetIndex::instance().size(), 0);
+    const int lowRank = Rank::Six().code();
+    for (uint64_t mask : MultisetIndex::multisets(MAX_CARDS, lowRank))
+    {
+        if (mask == 0)
+            continue;
+        int c[Suit::NUM_SUIT];
+        for (size_t k = 0; k < Suit::NUM_SUIT; k++)
+            c[k] = static_cast<int>(mask >> (lowRank + Rank::NUM_RANK * k)) & SUIT_RANKS;
+        int ranks = c[0] | c[1] | c[2] | c[3];
+
+        int code = CardSet(mask).evaluateHighRanks().code();
+        if ((ranks & LOW_STRAIGHT) == LOW_STRAIGHT && (code >> VSHIFT) < STRAIGHT)
+            code = (STRAIGHT << VSHIFT) ^ (Rank::Nine().code() << MAJOR_SHIFT);
+        table[rankIndex(c[0], c[1], c[2], c[3])] = reorder(code);
+    }
+    return table;
+}
+
+vector<int> buildFlushTable()
+{
+    vector<int> table(SUIT_RANKS + 1, 0);
+    for (int ranks = 0; ranks <= SUIT_RANKS; ranks++)
+    {
+        if (nRanksTable[ranks] < FULL_HAND_SIZE)
+            continue;
+        int code = CardSet(suitCards(ranks, 0)).evaluateHighFlush().code();
+        if ((ranks & LOW_STRAIGHT) == LOW_STRAIGHT && (code >> VSHIFT) != STRAIGHT_FLUSH)
+            code = (STRAIGHT_FLUSH << VSHIFT) ^ (Rank::Nine().code() << MAJOR_SHIFT);
+        table[ranks] = reorder(code);
+    }
+    return table;
+}
+}  // namespace
+
+const int* ShortDeckHandEvaluator::rankTable()
+{
+    static const vector<int> table = buildRankTable();
+    return table.data();
+}
+
+const int* ShortDeckHandEvaluator::flushTable()
+{
+    static const vector<int> table = buildFlushTable();
+    return table.data();
+}
+
+PokerEvaluation ShortDeckHandEvaluator::evaluateShortDeck(const CardSet& cards)
+{
+    uint64_t mask = cards.mask();
+    if ((mask & LOW_CARDS) != 0 || cards.size() > static_cast<size_t>(MAX_CARDS))
+        throw invalid_argument("ShortDeckHandEvaluator, not a short deck hand: " + cards.str());
+
+    int c = static_cast<int>(mask >> LOW_RANK) & SUIT_RANKS;
+    int d = static_cast<int>(mask >> (LOW_RANK + Rank::NUM_RANK)) & SUIT_RANKS;
+    int h = static_cast<int>(mask >> (LOW_RANK + 2 * Rank::NUM_RANK)) & SUIT_RANKS;
+    int s = static_cast<int>(mask >> (LOW_RANK + 3 * Rank::NUM_RANK)) & SUIT_RANKS;
+
+    // with seven cards at most one suit can have a flush, the table is
+    // zero for suits with fewer than five cards
+    const int* flushes = flushTable();
+    int code = rankTable()[rankIndex(c, d, h, s)];
+    code = max(code, flushes[c]);
+    code = max(code, flushes[d]);
+    code = max(code, flushes[h]);
+    code = max(code, flushes[s]);
+    return PokerEvaluation(code);
+}
+
+CardSet ShortDeckHandEvaluator::shortDeck()
+{
+    CardSet deck;
+    deck.fill();
+    return CardSet(deck.mask() & ~LOW_CARDS);
+}
+
+}  // namespace pokerstove
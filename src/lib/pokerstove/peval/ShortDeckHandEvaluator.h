@@ -0,0 +1,60 @@
+/**
+ * Copyright (c) 2012 Andrew Prock. All rights reserved.
+ */
+#ifndef PEVAL_SHORTDECKHANDEVALUATOR_H_
+#define PEVAL_SHORTDECKHANDEVALUATOR_H_
+
+#include "Card.h"
+#include "Holdem.h"
+#include "PokerHandEvaluator.h"
+
+namespace pokerstove
+{
+const size_t SHORT_DECK_SIZE = 36;
+const size_t SHORT_DECK_RANKS = 9;
+
+/**
+ * Short deck, or six plus, hold'em.  The deck is the 36 cards from six
+ * to ace, a flush beats a full house, and the ace plays low in the
+ * A6789 straight.  A straight still beats trips.
+ *
+ * Evaluation is two lookups in small tables.  One is indexed by the
+ * multiset of ranks and has everything from high card through quads
+ * and straights, the other is indexed by the nine bit rank mask of a
+ * suit and has the flushes.  The order bits of the evaluation code put
+ * flushes above full houses.
+ */
+class ShortDeckHandEvaluator : public PokerHandEvaluator
+{
+public:
+    virtual PokerHandEvaluation evaluateHand(const CardSet& hand, const CardSet& board) const
+    {
+        return PokerHandEvaluation(evaluateShortDeck(hand | board));
+    }
+
+    virtual size_t handSize() const { return NUM_HOLDEM_POCKET; }
+    virtual size_t boardSize() const { return BOARD_SIZE; }
+    virtual size_t evaluationSize() const { return 1; }
+    virtual CardSet deck() const { return shortDeck(); }
+
+    /**
+     * Evaluate up to seven cards, throws an invalid_argument if there
+     * are more, or if any of them is below a six.
+     */
+    static PokerEvaluation evaluateShortDeck(const CardSet& cards);
+
+    /**
+     * the 36 cards six through ace
+     */
+    static CardSet shortDeck();
+
+private:
+    static const size_t LOW_RANK = 4;  // the code of Rank::Six
+
+    static const int* rankTable();
+    static const int* flushTable();
+};
+
+}  // namespace pokerstove
+
+#endif  // PEVAL_SHORTDECKHANDEVALUATOR_H_
@@ -0,0 +1,107 @@
+#include "ShortDeckHandEvaluator.h"
+#include <random>
+#include <stdexcept>
+#include <pokerstove/util/combinations.h>
+#include <gtest/gtest.h>
+
+using namespace pokerstove;
+using namespace std;
+
+namespace
+{
+// five cards the slow way, the usual evaluation with the A6789
+// straight added and the types put in short deck order
+int referenceFive(const CardSet& cards)
+{
+    int code = cards.evaluateHigh().code();
+    int type = code >> VSHIFT;
+    if (cards.rankMask() == CardSet("Ac6c7c8c9c").rankMask())
+        code = ((type == FLUSH ? STRAIGHT_FLUSH : STRAIGHT) << VSHIFT) ^
+               (Rank::Nine().code() << MAJOR_SHIFT);
+
+    const int order[NUM_EVAL_TYPES] = {0, 0, 0, 0, 0, 0, 0, 0, 2, 1, 3, 3};
+    return code | order[code >> VSHIFT] << ORDER_SHIFT;
+}
+
+int reference(const CardSet& cards)
+{
+    vector<Card> c = cards.cards();
+    combinations five(c.size(), FULL_HAND_SIZE);
+    int best = 0;
+    do
+    {
+        CardSet hand;
+        for (size_t i = 0; i < FULL_HAND_SIZE; i++)
+            hand.insert(c[five[i]]);
+        best = max(best, referenceFive(hand));
+    } while (five.next());
+    return best;
+}
+}  // namespace
+
+TEST(ShortDeckHandEvaluator, Construct)
+{
+    std::shared_ptr<PokerHandEvaluator> eval = PokerHandEvaluator::alloc("6");
+    ASSERT_TRUE(eval.get() != NULL);
+    EXPECT_EQ(2, eval->handSize());
+    EXPECT_EQ(5, eval->boardSize());
+    EXPECT_EQ(SHORT_DECK_SIZE, eval->deck().size());
+    EXPECT_FALSE(eval->deck().contains(CardSet("5s")));
+    EXPECT_TRUE(eval->deck().contains(CardSet("6c")));
+}
+
+TEST(ShortDeckHandEvaluator, Ordering)
+{
+    ShortDeckHandEvaluator eval;
+    PokerEvaluation flush = eval.evaluateHand(CardSet("AhJh"), CardSet("9h7h6hKcKd")).high();
+    PokerEvaluation boat = eval.evaluateHand(CardSet("KhKs"), CardSet("9h9d6hKcTd")).high();
+    PokerEvaluation quads = eval.evaluateHand(CardSet("KhKs"), CardSet("9h7h6hKcKd")).high();
+    PokerEvaluation lowStraight = eval.evaluateHand(CardSet("Ac6d"), CardSet("7h8h9sKcJd")).high();
+    PokerEvaluation straight = eval.evaluateHand(CardSet("Tc6d"), CardSet("7h8h9sKcJd")).high();
+    PokerEvaluation trips = eval.evaluateHand(CardSet("AcAd"), CardSet("Ah8h9sKcJd")).high();
+    PokerEvaluation lowStraightFlush = eval.evaluateHand(CardSet("Ah6h"), CardSet("7h8h9hKcKd")).high();
+
+    EXPECT_EQ(FLUSH, flush.type());
+    EXPECT_EQ(FULL_HOUSE, boat.type());
+    EXPECT_EQ(STRAIGHT, lowStraight.type());
+    EXPECT_EQ(Rank::Nine(), lowStraight.majorRank());
+    EXPECT_EQ(STRAIGHT_FLUSH, lowStraightFlush.type());
+
+    EXPECT_GT(flush, boat);
+    EXPECT_GT(quads, flush);
+    EXPECT_GT(lowStraightFlush, quads);
+    EXPECT_GT(straight, lowStraight);
+    EXPECT_GT(lowStraight, trips);
+    EXPECT_GT(boat, straight);
+}
+
+TEST(ShortDeckHandEvaluator, MatchesReference)
+{
+    // every five card hand
+    vector<Card> deck = ShortDeckHandEvaluator::shortDeck().cards();
+    combinations five(deck.size(), FULL_HAND_SIZE);
+    do
+    {
+        CardSet hand;
+        for (size_t i = 0; i < FULL_HAND_SIZE; i++)
+            hand.insert(deck[five[i]]);
+        ASSERT_EQ(reference(hand), ShortDeckHandEvaluator::evaluateShortDeck(hand).code()) << hand.str();
+    } while (five.next());
+
+    // and a sample of the seven card hands
+    mt19937 rng(36);
+    for (size_t n = 0; n < 20000; n++)
+    {
+        shuffle(deck.begin(), deck.end(), rng);
+        CardSet hand;
+        for (size_t i = 0; i < 7; i++)
+            hand.insert(deck[i]);
+        ASSERT_EQ(reference(hand), ShortDeckHandEvaluator::evaluateShortDeck(hand).code()) << hand.str();
+    }
+}
+
+TEST(ShortDeckHandEvaluator, RejectsLowCards)
+{
+    ShortDeckHandEvaluator eval;
+    EXPECT_THROW(eval.evaluateHand(CardSet("AcKc"), CardSet("5c8d9h")), invalid_argument);
+}
@@ -0,0 +1,70 @@
+/**
+ * Copyright (c) 2012 Andrew Prock. All rights reserved.
+ */
+#include "ShowdownTally.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std;
+
+namespace pokerstove
+{
+
+ShowdownTally::ShowdownTally(size_t nplayers)
+    : _nplayers(nplayers)
+    , _stride(2 * nplayers + 1)
+    , _wins(nplayers * 3, 0)
+    , _ties(nplayers * (2 * nplayers + 1), 0)
+{
+    if (nplayers == 0 || nplayers > MAX_PLAYERS)
+        throw runtime_error("ShowdownTally, unsupported number of players");
+}
+
+void ShowdownTally::flush(vector<EquityResult>& results, double weight)
+{
+    for (size_t i = 0; i < _nplayers; i++)
+    {
+        const uint64_t* wins = &_wins[i * 3];
+        double winShares = wins[1] + 0.5 * wins[2];
+        if (winShares > 0.0)
+            results[i].winShares += weight * winShares;
+
+        const uint64_t* ties = &_ties[i * _stride];
+        double tieShares = 0.0;
+        for (size_t fraction = 2; fraction < _stride; fraction++)
+            if (ties[fraction] > 0)
+                tieShares += static_cast<double>(ties[fraction]) / fraction;
+        if (tieShares > 0.0)
+            results[i].tieShares += weight * tieShares;
+    }
+    clear();
+}
+
+void ShowdownTally::flush(vector<ExactEquityResult>& results, uint64_t weight)
+{
+    if (_nplayers > MAX_EXACT)
+        throw runtime_error("ShowdownTally, too many players for exact results");
+
+    const uint64_t pot = ExactEquityResult::UNITS_PER_POT;
+    for (size_t i = 0; i < _nplayers; i++)
+    {
+        const uint64_t* wins = &_wins[i * 3];
+        results[i].winUnits += weight * (wins[1] * pot + wins[2] * (pot / 2));
+
+        const uint64_t* ties = &_ties[i * _stride];
+        uint64_t tieUnits = 0;
+        for (size_t fraction = 2; fraction < _stride; fraction++)
+            tieUnits += ties[fraction] * (pot / fraction);
+        results[i].tieUnits += weight * tieUnits;
+    }
+    clear();
+}
+
+void ShowdownTally::clear()
+{
+    fill(_wins.begin(), _wins.end(), 0);
+    fill(_ties.begin(), _ties.end(), 0);
+}
+
+}  // namespace pokerstove
@@ -0,0 +1,182 @@
+/**
+ * Copyright (c) 2012 Andrew Prock. All rights reserved.
+ */
+#ifndef PEVAL_SHOWDOWNTALLY_H_
+#define PEVAL_SHOWDOWNTALLY_H_
+
+#include <cstdint>
+#include <vector>
+#include <pokerstove/util/lastbit.h>
+#include "PokerHandEvaluator.h"
+
+namespace pokerstove
+{
+/**
+ * Shares of the pot counted in integer units.  A pot is worth
+ * UNITS_PER_POT units, which is divisible by every tie of up to ten ways
+ * on either half of a split pot, so every showdown of up to ten players
+ * awards a whole number of units and sums of them are exact.
+ *
+ * The counters are 64 bits, with unit weights that is room for more
+ * than 10^15 showdowns.
+ */
+struct ExactEquityResult
+{
+    static const uint64_t UNITS_PER_POT = 5040;  // 2 * lcm(1..10)
+
+    uint64_t winUnits;
+    uint64_t tieUnits;
+
+    ExactEquityResult()
+        : winUnits(0)
+        , tieUnits(0)
+    {}
+
+    ExactEquityResult& operator+=(const ExactEquityResult& other)
+    {
+        winUnits += other.winUnits;
+        tieUnits += other.tieUnits;
+        return *this;
+    }
+
+    bool operator==(const ExactEquityResult& other) const
+    {
+        return winUnits == other.winUnits && tieUnits == other.tieUnits;
+    }
+
+    uint64_t units() const { return winUnits + tieUnits; }
+
+    /**
+     * the same shares as an EquityResult, in pots
+     */
+    EquityResult result() const
+    {
+        EquityResult ret;
+        ret.winShares = static_cast<double>(winUnits) / UNITS_PER_POT;
+        ret.tieShares = static_cast<double>(tieUnits) / UNITS_PER_POT;
+        return ret;
+    }
+
+    /**
+     * convert and normalize a set of exact results
+     */
+    static std::vector<EquityResult> results(
+        const std::vector<ExactEquityResult>& exact)
+    {
+        std::vector<EquityResult> ret;
+        for (const ExactEquityResult& e : exact)
+            ret.push_back(e.result());
+        EquityResult::normalize(ret);
+        return ret;
+    }
+};
+
+/**
+ * Integer share counting for showdowns.  Each showdown is given as an
+ * array of evaluation codes, one per player, and for split pot games a
+ * second array for the low half.  The winner is found with a max over
+ * the codes followed by a mask of the players which hold the max, both
+ * written as branch free loops over a flat int array so the compiler
+ * can vectorize them.
+ *
+ * Wins are counted per player and number of pots, ties per player and
+ * the pot fraction they were worth, all in integers.  The counts are
+ * converted to shares only when flushed, so a long run of showdowns with
+ * the same weight costs one multiply per player instead of one per
+ * showdown, and the shares do not drift as a sum of billions of small
+ * doubles would.
+ *
+ * At most MAX_PLAYERS players are supported, and at most MAX_EXACT
+ * players when flushing to exact results.
+ */
+class ShowdownTally
+{
+public:
+    static const size_t MAX_PLAYERS = 64;
+    static const size_t MAX_EXACT = 10;
+
+    explicit ShowdownTally(size_t nplayers);
+
+    size_t size() const { return _nplayers; }
+
+    /**
+     * award one high only showdown, returns
+     * PokerHandEvaluator::SHOWDOWN_TIE if the pot was tied and 0 otherwise
+     */
+    int add(const int* codes) { return award(codes, 1); }
+
+    /**
+     * award one showdown of a split pot game, a low code of zero means
+     * the hand has no low.  If nobody has a low the whole pot goes high.
+     * Returns a combination of PokerHandEvaluator::ShowdownFlags.
+     */
+    int add(const int* high, const int* low)
+    {
+        bool split = false;
+        for (size_t i = 0; i < _nplayers; i++)
+            split |= (low[i] > 0);
+        if (!split)
+            return award(high, 1);
+        return award(high, 2) | award(low, 2) | PokerHandEvaluator::SHOWDOWN_SPLIT;
+    }
+
+    /**
+     * number of pots (or half pots, if npots is 2) which player i won
+     * outright
+     */
+    uint64_t wins(size_t i, size_t npots = 1) const
+    {
+        return _wins[i * 3 + npots];
+    }
+
+    /**
+     * number of times player i tied for a 1/fraction share of the pot
+     */
+    uint64_t ties(size_t i, size_t fraction) const
+    {
+        return _ties[i * _stride + fraction];
+    }
+
+    /**
+     * Add the counted shares, scaled by weight, to the results and reset
+     * the counts.
+     */
+    void flush(std::vector<EquityResult>& results, double weight);
+    void flush(std::vector<ExactEquityResult>& results, uint64_t weight);
+
+    void clear();
+
+private:
+    int award(const int* codes, size_t npots)
+    {
+        int best = codes[0];
+        for (size_t i = 1; i < _nplayers; i++)
+            best = (codes[i] > best) ? codes[i] : best;
+
+        uint64_t mask = 0;
+        for (size_t i = 0; i < _nplayers; i++)
+            mask |= static_cast<uint64_t>(codes[i] == best) << i;
+
+        if ((mask & (mask - 1)) == 0)
+        {
+            _wins[lastbit(mask) * 3 + npots]++;
+            return 0;
+        }
+
+        size_t ways = 0;
+        for (uint64_t m = mask; m; m &= m - 1)
+            ways++;
+        for (; mask; mask &= mask - 1)
+            _ties[lastbit(mask) * _stride + ways * npots]++;
+        return PokerHandEvaluator::SHOWDOWN_TIE;
+    }
+
+    size_t _nplayers;
+    size_t _stride;
+    std::vector<uint64_t> _wins;  // [player][npots]
+    std::vector<uint64_t> _ties;  // [player][fraction]
+};
+
+}  // namespace pokerstove
+
+#endif  // PEVAL_SHOWDOWNTALLY_H_
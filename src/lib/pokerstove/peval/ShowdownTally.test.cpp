@@ -0,0 +1,110 @@
+#include "ShowdownTally.h"
+#include <gtest/gtest.h>
+
+using namespace pokerstove;
+using namespace std;
+
+TEST(ShowdownTally, WinsAndTies)
+{
+    ShowdownTally tally(4);
+    int win[] = {3, 9, 1, 5};
+    int tie2[] = {7, 2, 7, 1};
+    int tie4[] = {4, 4, 4, 4};
+    EXPECT_EQ(0, tally.add(win));
+    EXPECT_EQ(PokerHandEvaluator::SHOWDOWN_TIE, tally.add(tie2));
+    EXPECT_EQ(PokerHandEvaluator::SHOWDOWN_TIE, tally.add(tie4));
+    EXPECT_EQ(1, tally.wins(1));
+    EXPECT_EQ(0, tally.wins(0));
+    EXPECT_EQ(0, tally.wins(1, 2));
+    EXPECT_EQ(1, tally.ties(0, 2));
+    EXPECT_EQ(1, tally.ties(2, 2));
+    EXPECT_EQ(0, tally.ties(1, 2));
+    EXPECT_EQ(1, tally.ties(3, 4));
+
+    vector<EquityResult> results(4, EquityResult());
+    tally.flush(results, 2.0);
+    EXPECT_DOUBLE_EQ(2.0, results[1].winShares);
+    EXPECT_DOUBLE_EQ(2.0 * (0.5 + 0.25), results[0].tieShares);
+    EXPECT_DOUBLE_EQ(2.0 * 0.25, results[1].tieShares);
+    EXPECT_DOUBLE_EQ(2.0 * 0.25, results[3].tieShares);
+
+    // flushing resets the counts
+    EXPECT_EQ(0, tally.wins(1));
+    tally.flush(results, 1.0);
+    EXPECT_DOUBLE_EQ(2.0, results[1].winShares);
+}
+
+TEST(ShowdownTally, MatchesEvaluateShowdown)
+{
+    std::shared_ptr<PokerHandEvaluator> peval = PokerHandEvaluator::alloc("h");
+    vector<CardSet> hands;
+    hands.push_back(CardSet("AcAd"));
+    hands.push_back(CardSet("AhAs"));
+    hands.push_back(CardSet("KcKd"));
+    CardSet board("2c7h9sTdJh");
+
+    vector<PokerHandEvaluation> evals(hands.size());
+    vector<EquityResult> expected(hands.size(), EquityResult());
+    peval->evaluateShowdown(hands, board, evals, expected, 1.0);
+
+    ShowdownTally tally(hands.size());
+    vector<int> codes;
+    for (const CardSet& hand : hands)
+        codes.push_back(peval->evaluateHand(hand, board).high().code());
+    tally.add(codes.data());
+    vector<EquityResult> results(hands.size(), EquityResult());
+    tally.flush(results, 1.0);
+
+    for (size_t i = 0; i < hands.size(); i++)
+    {
+        EXPECT_DOUBLE_EQ(expected[i].winShares, results[i].winShares);
+        EXPECT_DOUBLE_EQ(expected[i].tieShares, results[i].tieShares);
+    }
+}
+
+TEST(ShowdownTally, SplitPots)
+{
+    ShowdownTally tally(3);
+    int high[] = {9, 5, 5};
+    int low[] = {0, 3, 3};
+    int none[] = {0, 0, 0};
+    EXPECT_EQ(PokerHandEvaluator::SHOWDOWN_TIE | PokerHandEvaluator::SHOWDOWN_SPLIT,
+              tally.add(high, low));
+    EXPECT_EQ(0, tally.add(high, none));
+    EXPECT_EQ(1, tally.wins(0, 1));
+    EXPECT_EQ(1, tally.wins(0, 2));
+    EXPECT_EQ(1, tally.ties(1, 4));
+    EXPECT_EQ(1, tally.ties(2, 4));
+
+    vector<EquityResult> results(3, EquityResult());
+    tally.flush(results, 1.0);
+    EXPECT_DOUBLE_EQ(1.5, results[0].winShares);
+    EXPECT_DOUBLE_EQ(0.25, results[1].tieShares);
+}
+
+TEST(ShowdownTally, Exact)
+{
+    ShowdownTally tally(4);
+    int win[] = {3, 9, 1, 5};
+    int tie3[] = {7, 2, 7, 7};
+    int low[] = {1, 0, 1, 0};
+    tally.add(win);
+    tally.add(tie3);
+    tally.add(tie3, low);
+
+    const uint64_t pot = ExactEquityResult::UNITS_PER_POT;
+    vector<ExactEquityResult> exact(4);
+    tally.flush(exact, 3);
+    EXPECT_EQ(3 * pot, exact[1].winUnits);
+    EXPECT_EQ(3 * (pot / 3 + pot / 6 + pot / 4), exact[0].tieUnits);
+    EXPECT_EQ(3 * (pot / 3 + pot / 6), exact[3].tieUnits);
+
+    // every showdown hands out exactly one pot
+    uint64_t total = 0;
+    for (const ExactEquityResult& e : exact)
+        total += e.units();
+    EXPECT_EQ(3 * 3 * pot, total);
+
+    vector<EquityResult> results = ExactEquityResult::results(exact);
+    EXPECT_DOUBLE_EQ(1.0 / 3.0, results[1].equity);
+}
@@ -0,0 +1,85 @@
+/**
+ * Copyright (c) 2012 Andrew Prock. All rights reserved.
+ */
+#include "UniversalHandEvaluator.h"
+
+#include <vector>
+#include <pokerstove/util/lastbit.h>
+
+using namespace std;
+
+namespace pokerstove
+{
+
+namespace
+{
+const size_t MAX_SUBSET_SIZE = UniversalHandEvaluator::MAX_SUBSET_CARDS;
+
+// For each subset size, every set of card indices of that size as a bit
+// mask, in increasing order.  That is colex order, so the subsets of the
+// first n cards are exactly the masks below 1<<n and one table serves
+// every size of hand.
+struct SubsetTable
+{
+    vector<uint8_t> masks[MAX_SUBSET_SIZE + 1];
+
+    SubsetTable()
+    {
+        for (unsigned int m = 0; m < (1u << MAX_SUBSET_SIZE); m++)
+        {
+            size_t bits = 0;
+            for (unsigned int x = m; x; x &= x - 1)
+                bits++;
+            masks[bits].push_back(static_cast<uint8_t>(m));
+        }
+    }
+};
+
+const SubsetTable& subsetTable()
+{
+    static const SubsetTable table;
+    return table;
+}
+}  // namespace
+
+size_t UniversalHandEvaluator::fillSubsets(uint64_t* candidates,
+                                           size_t subsetsize,
+                                           const CardSet& cards)
+{
+    size_t n = cards.size();
+    if (subsetsize > n)
+    {
+        candidates[0] = 0;
+        return 1;
+    }
+    if (subsetsize == 0)
+    {
+        candidates[0] = cards.mask();
+        return 1;
+    }
+    if (n > MAX_SUBSET_CARDS)
+        throw std::invalid_argument(std::string("UnivHandEval: ")
+                                    + boost::lexical_cast<std::string>(uint(n))
+                                    + ": too many cards to choose from");
+
+    uint64_t clist[MAX_SUBSET_CARDS];
+    uint64_t mask = cards.mask();
+    for (size_t i = 0; i < n; i++)
+    {
+        clist[i] = mask & (~mask + 1);
+        mask &= mask - 1;
+    }
+
+    const vector<uint8_t>& subsets = subsetTable().masks[subsetsize];
+    size_t count = 0;
+    for (size_t s = 0; s < subsets.size() && subsets[s] < (1u << n); s++)
+    {
+        uint64_t cand = 0;
+        for (unsigned int m = subsets[s]; m; m &= m - 1)
+            cand |= clist[lastbit(static_cast<uint32_t>(m))];
+        candidates[count++] = cand;
+    }
+    return count;
+}
+
+}  // namespace pokerstove
@@ -16,9 +16,9 @@
 //  eval a: high/low/227/A25/Badugi/3CP
 //  eval b: high/low/227/A25/Badugi/3CP
 
-#include <vector>
+#include <cstdint>
+#include <stdexcept>
 #include <boost/lexical_cast.hpp>
-#include <pokerstove/util/combinations.h>
 #include "Card.h"
 #include "CardSet.h"
 #include "PokerHandEvaluator.h"
@@ -83,19 +83,72 @@ public:
 
     virtual PokerHandEvaluation evaluateHand(const CardSet& hand, const CardSet& board) const
     {
+        uint64_t hands[MAX_SUBSETS];
+        uint64_t boards[MAX_SUBSETS];
+        size_t nhands, nboards;
+        fillCandidates(hand, board, hands, nhands, boards, nboards);
+
+        // evaluation of the first type.  we do a quick evaluation
+        // of the one candidate which *must* be there, and then if
+        // there are more candidates, we just run through them updating
+        // as we find better ones.
         PokerEvaluation eval[2];
+        eval[0] = (CardSet(hands[0] | boards[0]).*(_evalA))();
+        for (size_t i = 0; i < nhands; i++)
+            for (size_t j = 0; j < nboards; j++)
+            {
+                PokerEvaluation e = (CardSet(hands[i] | boards[j]).*(_evalA))();
+                if (e > eval[0])
+                    eval[0] = e;
+            }
+
+        // second dimension of the evaulation, usually low in a high/low game.
+        if (_evalB != evalFunction(NULL))
+            for (size_t i = 0; i < nhands; i++)
+                for (size_t j = 0; j < nboards; j++)
+                {
+                    PokerEvaluation e = (CardSet(hands[i] | boards[j]).*(_evalB))();
+                    if (e > eval[1])
+                        eval[1] = e;
+                }
+
+        return PokerHandEvaluation(eval[0], eval[1]);
+    }
+
+    /**
+     * The largest set of cards we can take subsets of, and the largest
+     * number of subsets of any one size that can produce.
+     */
+    static const size_t MAX_SUBSET_CARDS = 8;
+    static const size_t MAX_SUBSETS = 70;
 
+    /**
+     * All the subsetsize card subsets of cards, written to candidates as
+     * card masks, returns the number written.  A subset size of zero
+     * is the whole set, and a subset larger than the set is a single
+     * empty candidate.  Subsets come from a precomputed table, so no
+     * memory is allocated.
+     */
+    static size_t fillSubsets(uint64_t* candidates, size_t subsetsize, const CardSet& cards);
+
+    virtual size_t evalsPerHand() const { return _evalsperhand; }
+
+protected:
+    /**
+     * check the input against the game and fill in the hand and board
+     * candidates, the reference example is omaha where a player must
+     * use two cards from their hand, and three from the board.
+     */
+    void fillCandidates(const CardSet& hand, const CardSet& board,
+                        uint64_t* hands, size_t& nhands,
+                        uint64_t* boards, size_t& nboards) const
+    {
         // check to see if the input hand is consistent with the game
         if (hand.size() < _heromin ||
             hand.size() > _heromax)
             throw std::invalid_argument(std::string("UnivHandEval: "
                                                     + boost::lexical_cast<std::string>(uint(hand.size()))
                                                     + ": invalid number of pocket cards"));
-        CardSet h = hand;
-
-        std::vector<CardSet> hand_candidates;
-        std::vector<CardSet> board_candidates;
-        std::vector<CardSet> eval_candidates;
 
         // now check the board, it's a distribution
         size_t bz = board.size();
@@ -105,76 +158,10 @@ public:
                                                     + boost::lexical_cast<std::string>((uint)board.size())
                                                     + " unsupported number of board cards"));
 
-        // generate the possible sub parts, the reference example is omaha
-        // where a player must use two cards from their hand, and three
-        // from the board.
-        fillSubsets(hand_candidates, _herouse, h);
-        fillSubsets(board_candidates, boardSize()-_herouse, board);
-
-        // combine the subset candidates to create all possible sets of evaluations
-        // at the river in omaha, this should produce (4c2)*(5c3) = 6*10 = 60 candidates
-        for (uint i=0; i<hand_candidates.size(); i++)
-            for (uint j=0; j<board_candidates.size(); j++) {
-                eval_candidates.push_back(hand_candidates[i] | board_candidates[j]);
-            }
-
-        // evaluation of the first type.  we do a quick evaluation
-        // of the one candidate which *must* be there, and then if
-        // there are more candidates, we just run through them updating
-        // as we find better ones.
-        eval[0] = ((eval_candidates[0]).*(_evalA))();
-        for (uint i=1; i<eval_candidates.size(); i++) {
-            PokerEvaluation e = ((eval_candidates[i]).*(_evalA))();
-            if (e > eval[0])
-                eval[0] = e;
-        }
-
-        // if it's a one dimensional evaluation we are done
-        if (_evalB != evalFunction(NULL))
-        {
-            // second dimension of the evaulation, usually low in a high/low game.
-            eval[1] = PokerEvaluation();
-            for (uint i=0; i<eval_candidates.size(); i++)
-            {
-                PokerEvaluation e = ((eval_candidates[i]).*(_evalB))();
-                if (e > eval[1])
-                {
-                    eval[1] = e;
-                }
-            }
-        }
-        return PokerHandEvaluation(eval[0],eval[1]);
+        nhands = fillSubsets(hands, _herouse, hand);
+        nboards = fillSubsets(boards, boardSize() - _herouse, board);
     }
 
-    void fillSubsets(std::vector<CardSet> & candidates, size_t subsetsize, CardSet cards) const
-    {
-        if (subsetsize > cards.size())
-        {
-            candidates.push_back(CardSet());
-            return;
-        }
-        if (subsetsize == 0)
-        {
-            candidates.push_back(cards);
-            return;
-        }
-
-        std::vector<Card> clist = cards.cards();
-        pokerstove::combinations cc(static_cast<uint>(clist.size()), static_cast<uint>(subsetsize));
-        do
-        {
-            CardSet cand;
-            for (size_t i=0; i<subsetsize; i++)
-            {
-                cand.insert(clist[cc[static_cast<uint>(i)]]);
-            }
-            candidates.push_back(cand);
-        }
-        while (cc.nextcomb());
-    }
-
-    virtual size_t evalsPerHand() const { return _evalsperhand; }
-
 private:
     size_t _heromin;
     size_t _heromax;
@@ -186,6 +173,52 @@ private:
     int _evalsperhand;
 };
 
+/**
+ * A UniversalHandEvaluator with the evaluation functions fixed at
+ * compile time, so that each candidate is evaluated with a direct call
+ * rather than through a pointer to member.  This is what the factory
+ * uses for the rule driven games.
+ */
+template <evalFunction EvalA, evalFunction EvalB = nullptr>
+class StaticUniversalHandEvaluator : public UniversalHandEvaluator
+{
+public:
+    StaticUniversalHandEvaluator(int heromin, int heromax,
+                                 int boardmin, int boardmax,
+                                 int herouse)
+        : UniversalHandEvaluator(heromin, heromax, boardmin, boardmax, herouse, EvalA, EvalB)
+    {}
+
+    virtual PokerHandEvaluation evaluateHand(const CardSet& hand, const CardSet& board) const
+    {
+        uint64_t hands[MAX_SUBSETS];
+        uint64_t boards[MAX_SUBSETS];
+        size_t nhands, nboards;
+        fillCandidates(hand, board, hands, nhands, boards, nboards);
+
+        PokerEvaluation eval[2];
+        eval[0] = (CardSet(hands[0] | boards[0]).*EvalA)();
+        for (size_t i = 0; i < nhands; i++)
+            for (size_t j = 0; j < nboards; j++)
+            {
+                PokerEvaluation e = (CardSet(hands[i] | boards[j]).*EvalA)();
+                if (e > eval[0])
+                    eval[0] = e;
+            }
+
+        if (EvalB != nullptr)
+            for (size_t i = 0; i < nhands; i++)
+                for (size_t j = 0; j < nboards; j++)
+                {
+                    PokerEvaluation e = (CardSet(hands[i] | boards[j]).*EvalB)();
+                    if (e > eval[1])
+                        eval[1] = e;
+                }
+
+        return PokerHandEvaluation(eval[0], eval[1]);
+    }
+};
+
 }
 
 #endif  // PEVAL_UNIVERSALHANDEVALUATOR_H_
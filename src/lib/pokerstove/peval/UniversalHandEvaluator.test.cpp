@@ -33,3 +33,52 @@ TEST(UniversalHandEvaluator, SixCardOmaha)
     EXPECT_EQ(Rank("3"), eval.majorRank());
     EXPECT_EQ(Rank("2"), eval.minorRank());
 }
+
+TEST(UniversalHandEvaluator, FillSubsets)
+{
+    uint64_t candidates[UniversalHandEvaluator::MAX_SUBSETS];
+    CardSet cards("2c3d4h5s6c");
+    EXPECT_EQ(10, UniversalHandEvaluator::fillSubsets(candidates, 3, cards));
+    for (size_t i = 0; i < 10; i++)
+    {
+        EXPECT_EQ(3, CardSet(candidates[i]).size());
+        EXPECT_TRUE(cards.contains(CardSet(candidates[i])));
+        for (size_t j = 0; j < i; j++)
+            EXPECT_NE(candidates[i], candidates[j]);
+    }
+
+    // whole set, and the single empty candidate
+    EXPECT_EQ(1, UniversalHandEvaluator::fillSubsets(candidates, 0, cards));
+    EXPECT_EQ(cards.mask(), candidates[0]);
+    EXPECT_EQ(1, UniversalHandEvaluator::fillSubsets(candidates, 6, cards));
+    EXPECT_EQ(0, candidates[0]);
+}
+
+TEST(UniversalHandEvaluator, StaticMatchesDynamic)
+{
+    UniversalHandEvaluator dynamic(5, 5, 3, 5, 2, &CardSet::evaluateHigh,
+                                   &CardSet::evaluate8LowA5);
+    StaticUniversalHandEvaluator<&CardSet::evaluateHigh, &CardSet::evaluate8LowA5>
+        fixed(5, 5, 3, 5, 2);
+    CardSet hand("2d3dKhQd8h");
+    const char* boards[] = {"2c3c4c", "2c3c4cAh", "2c3c4cAh7d"};
+    for (const char* b : boards)
+    {
+        CardSet board(b);
+        EXPECT_EQ(dynamic.evaluateHand(hand, board).high().code(),
+                  fixed.evaluateHand(hand, board).high().code());
+        EXPECT_EQ(dynamic.evaluateHand(hand, board).low().code(),
+                  fixed.evaluateHand(hand, board).low().code());
+    }
+    EXPECT_EQ(2, fixed.evaluationSize());
+}
+
+TEST(UniversalHandEvaluator, StudHighLow)
+{
+    StaticUniversalHandEvaluator<&CardSet::evaluateHigh, &CardSet::evaluateLowA5>
+        eval(1, 7, 0, 0, 0);
+    CardSet hand("AcAd2h3s4c5dKh");
+    PokerHandEvaluation e = eval.evaluateHand(hand, CardSet());
+    EXPECT_EQ(hand.evaluateHigh().code(), e.high().code());
+    EXPECT_EQ(hand.evaluateLowA5().code(), e.low().code());
+}
@@ -1,3 +1,6 @@
+#ifndef UTIL_TIMING_HPP_
+#define UTIL_TIMING_HPP_
+
 #include <boost/chrono.hpp>
 #include <boost/timer/timer.hpp>
 
@@ -13,10 +16,22 @@ namespace pokerstove
  * input: boost timer
  * output: number of elapsed wall seconds as a double
  */
-double elapsed(boost::timer::cpu_timer timer) {
+inline double elapsed(boost::timer::cpu_timer timer) {
     boost::timer::nanosecond_type elapsed = timer.elapsed().wall;
     double nanos = static_cast<double>(boost::chrono::nanoseconds(elapsed).count());
     return nanos * boost::chrono::nanoseconds::period::num / boost::chrono::nanoseconds::period::den;
 }
 
+/**
+ * input: boost timer
+ * output: number of elapsed cpu seconds, user plus system, as a double
+ */
+inline double elapsedCpu(boost::timer::cpu_timer timer) {
+    boost::timer::cpu_times times = timer.elapsed();
+    double nanos = static_cast<double>(boost::chrono::nanoseconds(times.user + times.system).count());
+    return nanos * boost::chrono::nanoseconds::period::num / boost::chrono::nanoseconds::period::den;
+}
+
 }
+
+#endif  // UTIL_TIMING_HPP_
@@ -1,12 +1,225 @@
+#include <algorithm>
+#include <boost/format.hpp>
 #include <boost/program_options.hpp>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
 #include <iostream>
+#include <memory>
+#include <sstream>
+#include <pokerstove/penum/EnumerationCheckpoint.h>
+#include <pokerstove/penum/EquityJob.h>
+#include <pokerstove/penum/OutsEnumerator.h>
+#include <pokerstove/penum/PreflopClasses.h>
+#include <pokerstove/penum/RangeDistribution.h>
 #include <pokerstove/penum/ShowdownEnumerator.h>
+#include <thread>
 #include <vector>
 
+#ifdef WIN32
+#include <io.h>
+#define isatty _isatty
+#define fileno _fileno
+#else
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
 using namespace pokerstove;
 namespace po = boost::program_options;
 using namespace std;
 
+namespace
+{
+volatile sig_atomic_t interrupted = 0;
+
+// the first interrupt stops the enumeration and prints what we have, a
+// second one kills the program as usual
+void onInterrupt(int)
+{
+    interrupted = 1;
+    signal(SIGINT, SIG_DFL);
+}
+
+void printProgress(const EquityJob& job)
+{
+    const int width = 40;
+    int filled = static_cast<int>(job.fraction() * width);
+    cerr << "\r[" << string(filled, '#') << string(width - filled, ' ') << "] "
+         << boost::format("%5.1f%% %.3g evals/s ") % (job.fraction() * 100.0)
+                % job.evaluationsPerSecond()
+         << flush;
+}
+
+void printResults(const vector<EquityResult>& results, const vector<string>& hands)
+{
+    double total = 0.0;
+    for (const EquityResult& result : results)
+    {
+        total += result.winShares + result.tieShares;
+    }
+
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        double equity =
+            (results[i].winShares + results[i].tieShares) / total;
+        string handDesc =
+            (i < hands.size()) ? "The hand " + hands[i] : "A random hand";
+        cout << handDesc << " has " << equity * 100. << " % equity ("
+             << results[i].str() << ")" << endl;
+    }
+}
+
+/**
+ * The hands of the distribution which only use cards from the deck, so
+ * ranges written for the full deck work in short deck games.
+ */
+CardDistribution inDeck(const CardDistribution& dist, const CardSet& deck)
+{
+    CardDistribution ret;
+    ret.clear();
+    for (size_t i = 0; i < dist.size(); i++)
+        if ((dist[i] & deck) == dist[i])
+            ret.insert(dist[i], dist[dist[i]]);
+    return ret;
+}
+
+/**
+ * How each hand of each range did, best first.  Two card hands are
+ * grouped into their preflop classes.
+ */
+void printCombos(const vector<ComboResult>& combos,
+                 const vector<CardDistribution>& dists,
+                 const vector<string>& hands)
+{
+    vector<size_t> offsets = ShowdownEnumerator::comboOffsets(dists);
+    for (size_t i = 0; i < dists.size(); ++i)
+    {
+        const CardDistribution& dist = dists[i];
+        if (dist.size() < 2)
+            continue;
+
+        // one row per class, or per hand
+        bool classes = (dist[0].size() == 2);
+        vector<string> names;
+        vector<ComboResult> rows;
+        vector<size_t> counts;
+        vector<size_t> row(classes ? NUM_PREFLOP_CLASSES : 0, SIZE_MAX);
+        for (size_t h = 0; h < dist.size(); h++)
+        {
+            size_t r = names.size();
+            if (classes)
+            {
+                size_t cls = preflopClass(dist[h]);
+                if (row[cls] == SIZE_MAX)
+                {
+                    row[cls] = names.size();
+                    names.push_back(preflopClassName(cls));
+                    rows.push_back(ComboResult());
+                    counts.push_back(0);
+                }
+                r = row[cls];
+            }
+            else
+            {
+                names.push_back(dist[h].str());
+                rows.push_back(ComboResult());
+                counts.push_back(0);
+            }
+            rows[r] += combos[offsets[i] + h];
+            counts[r]++;
+        }
+
+        vector<size_t> order(rows.size());
+        for (size_t r = 0; r < order.size(); r++)
+            order[r] = r;
+        stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            return rows[a].equity() > rows[b].equity();
+        });
+
+        string handDesc = (i < hands.size()) ? hands[i] : "random";
+        cout << "\n" << handDesc << " by " << (classes ? "class" : "hand") << ":" << endl;
+        for (size_t r : order)
+            cout << boost::format("  %-12s %5d %8.3f %%\n") % names[r] % counts[r]
+                        % (rows[r].equity() * 100.0);
+    }
+}
+
+/**
+ * Split the enumeration into work units and run each in its own
+ * process, the parts are passed back through files and merged.  Returns
+ * false if a worker failed.
+ */
+bool runWorkers(const vector<CardDistribution>& dists,
+                const CardSet& board,
+                std::shared_ptr<PokerHandEvaluator> evaluator,
+                size_t procs,
+                bool exact,
+                PartialEquity& merged)
+{
+    ShowdownEnumerator showdown;
+    uint64_t total = showdown.countShowdowns(dists, board, evaluator);
+    vector<PartialEquity::Range> units = PartialEquity::split(total, procs);
+    merged = PartialEquity(PartialEquity::fingerprint(dists, board, *evaluator),
+                           total, dists.size(), exact);
+
+#ifdef WIN32
+    // no fork, run the units one after the other
+    for (const PartialEquity::Range& unit : units)
+        merged.merge(showdown.calculatePartialEquity(
+            dists, board, evaluator, unit.first, unit.second, exact));
+    return merged.complete();
+#else
+    const char* tmpdir = getenv("TMPDIR");
+    string prefix = string(tmpdir ? tmpdir : "/tmp") + "/ps-eval." +
+                    to_string(getpid()) + ".";
+    cout.flush();
+    cerr.flush();
+
+    vector<pid_t> workers;
+    for (size_t i = 0; i < units.size(); i++)
+    {
+        pid_t pid = fork();
+        if (pid < 0)
+            break;
+        if (pid == 0)
+        {
+            int status = 1;
+            try
+            {
+                PartialEquity part = showdown.calculatePartialEquity(
+                    dists, board, evaluator, units[i].first, units[i].second, exact);
+                if (part.save(prefix + to_string(i)))
+                    status = 0;
+            }
+            catch (std::exception& e)
+            {
+                cerr << "worker " << i << " failed: " << e.what() << endl;
+            }
+            _exit(status);
+        }
+        workers.push_back(pid);
+    }
+
+    bool ok = (workers.size() == units.size());
+    for (size_t i = 0; i < workers.size(); i++)
+    {
+        int status = 0;
+        waitpid(workers[i], &status, 0);
+        ok = ok && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+
+        string filename = prefix + to_string(i);
+        PartialEquity part;
+        ok = ok && part.load(filename) && merged.merge(part);
+        remove(filename.c_str());
+    }
+    return ok && merged.complete();
+#endif
+}
+}  // namespace
+
 int main(int argc, char** argv)
 {
     po::options_description desc("ps-eval, a poker hand evaluator\n");
@@ -15,7 +228,19 @@ int main(int argc, char** argv)
         ("help,?",  "produce help message")
         ("game,g",  po::value<string>()->default_value("h"),    "game to use for evaluation")
         ("board,b", po::value<string>(),                        "community cards for he/o/o8")
-        ("hand,h",  po::value<vector<string>>(),                "a hand for evaluation")
+        ("hand,h",  po::value<vector<string>>(),                "a hand or range for evaluation, e.g. QQ+,AKs")
+        ("ordering,o", po::value<string>(),                     "hand ordering file from ps-order, for N% ranges")
+        ("max-time,t", po::value<double>(),                     "stop after this many seconds and report partial results")
+        ("exact",   "count shares exactly in integers, needs whole number weights")
+        ("procs,j", po::value<size_t>(),                        "split the enumeration across this many processes")
+        ("shard",   po::value<string>(),                        "run only work unit i/n of the enumeration, see --partial")
+        ("partial", po::value<string>(),                        "file to save the results of a --shard to, for ps-merge")
+        ("checkpoint", po::value<string>(),                     "save progress to this file, for --resume")
+        ("resume",  po::value<string>(),                        "continue from a checkpoint file, and keep saving to it")
+        ("checkpoint-interval", po::value<double>()->default_value(60.0), "seconds between checkpoints")
+        ("combos",  "also break each range down by hand, or by preflop class for two card games")
+        ("outs",    "list the next cards which change the lead, for the first hand against the rest")
+        ("stats",   "print enumeration statistics")
         ("quiet,q", "produces no output");
 
     // make hand a positional argument
@@ -47,41 +272,260 @@ int main(int argc, char** argv)
 
     // allocate evaluator and create card distributions
     std::shared_ptr<PokerHandEvaluator> evaluator = PokerHandEvaluator::alloc(game);
+    if (!evaluator)
+    {
+        cerr << "unknown game: " << game << endl;
+        return 1;
+    }
+    std::shared_ptr<HandOrdering> ordering;
+    if (vm.count("ordering"))
+    {
+        ordering.reset(new HandOrdering);
+        if (!ordering->load(vm["ordering"].as<string>()))
+        {
+            cerr << "unable to load ordering: " << vm["ordering"].as<string>() << endl;
+            return 1;
+        }
+    }
+
     vector<CardDistribution> handDists;
     for (const string& hand : hands)
     {
-        handDists.emplace_back();
-        handDists.back().parse(hand);
+        RangeDistribution range(evaluator->handSize());
+        range.setOrdering(ordering);
+        if (!range.parse(hand))
+        {
+            cerr << "unable to parse hand or range: " << hand << endl;
+            return 1;
+        }
+        handDists.push_back(inDeck(range.data(), evaluator->deck()));
+        if (handDists.back().size() == 0)
+        {
+            cerr << "no hands in the deck of the game: " << hand << endl;
+            return 1;
+        }
     }
 
     // fill with random if necessary
     if (handDists.size() == 1)
     {
         handDists.emplace_back();
-        handDists.back().fill(evaluator->handSize());
+        handDists.back().fill(evaluator->deck(), evaluator->handSize());
     }
 
-    // calcuate the results and print them
-    ShowdownEnumerator showdown;
-    vector<EquityResult> results =
-        showdown.calculateEquity(handDists, CardSet(board), evaluator);
+    if (vm.count("outs"))
+    {
+        const char* enumeration[] = {"max-time", "exact", "procs", "shard",
+                                     "partial", "checkpoint", "resume",
+                                     "combos", "stats"};
+        for (const char* option : enumeration)
+            if (vm.count(option))
+            {
+                cerr << "--outs does not run an equity enumeration, it cannot "
+                        "be used with --" << option << endl;
+                return 1;
+            }
+        if (handDists[0].size() != 1)
+        {
+            cerr << "--outs needs a single first hand" << endl;
+            return 1;
+        }
+        vector<CardDistribution> opponents(handDists.begin() + 1, handDists.end());
+        OutsEnumerator enumerator;
+        vector<OutsResult> outs;
+        try
+        {
+            outs = OutsEnumerator::outs(enumerator.calculateOuts(
+                handDists[0][0], opponents, CardSet(board), evaluator));
+        }
+        catch (std::exception& e)
+        {
+            cerr << e.what() << endl;
+            return 1;
+        }
+        if (!quiet)
+        {
+            cout << boost::format("%d outs for %s\n") % outs.size() % hands[0];
+            for (const OutsResult& r : outs)
+                cout << boost::format("  %s   gains %6.2f %%   loses %6.2f %%\n")
+                            % r.card.str() % (100.0 * r.gainedFraction())
+                            % (100.0 * r.lostFraction());
+        }
+        return 0;
+    }
 
-    double total = 0.0;
-    for (const EquityResult& result : results)
+    // a slice of the enumeration, saved for ps-merge
+    CardSet boardCards(board);
+    bool exact = vm.count("exact") > 0;
+    bool combos = vm.count("combos") > 0;
+    if (combos && (exact || vm.count("procs") || vm.count("shard") ||
+                   vm.count("checkpoint") || vm.count("resume")))
     {
-        total += result.winShares + result.tieShares;
+        cerr << "--combos needs a single enumeration, without --exact, --procs, "
+                "--shard, or checkpoints" << endl;
+        return 1;
+    }
+    // statistics are only gathered in this process
+    bool checkpointing = vm.count("checkpoint") || vm.count("resume");
+    if (vm.count("stats") && (vm.count("shard") || vm.count("procs") ||
+                              (exact && !checkpointing)))
+    {
+        cerr << "--stats needs a single enumeration in this process, without "
+                "--procs, --shard, or --exact without a checkpoint" << endl;
+        return 1;
+    }
+    if (vm.count("shard"))
+    {
+        size_t unit, units;
+        char slash;
+        istringstream shard(vm["shard"].as<string>());
+        if (!(shard >> unit >> slash >> units) || slash != '/' || unit >= units ||
+            vm.count("partial") == 0)
+        {
+            cerr << "--shard needs i/n with i < n, and a --partial file" << endl;
+            return 1;
+        }
+        try
+        {
+            ShowdownEnumerator showdown;
+            uint64_t total = showdown.countShowdowns(handDists, boardCards, evaluator);
+            PartialEquity::Range range = PartialEquity::split(total, units)[unit];
+            PartialEquity part = showdown.calculatePartialEquity(
+                handDists, boardCards, evaluator, range.first, range.second, exact);
+            part.setLabels(hands);
+            if (!part.save(vm["partial"].as<string>()))
+            {
+                cerr << "unable to save partial results: " << vm["partial"].as<string>() << endl;
+                return 1;
+            }
+            if (!quiet)
+                cout << boost::format("showdowns %d to %d of %d saved to %s\n")
+                            % range.first % range.second % total
+                            % vm["partial"].as<string>();
+        }
+        catch (std::exception& e)
+        {
+            cerr << "enumeration failed: " << e.what() << endl;
+            return 1;
+        }
+        return 0;
     }
 
-    if (!quiet)
+    // exact counts and multiple processes both go through work units
+    if ((exact || vm.count("procs")) && !checkpointing)
     {
-        for (size_t i = 0; i < results.size(); ++i)
+        size_t procs = vm.count("procs") ? max<size_t>(vm["procs"].as<size_t>(), 1) : 1;
+        PartialEquity merged;
+        try
         {
-            double equity =
-                (results[i].winShares + results[i].tieShares) / total;
-            string handDesc =
-                (i < hands.size()) ? "The hand " + hands[i] : "A random hand";
-            cout << handDesc << " has " << equity * 100. << " % equity ("
-                 << results[i].str() << ")" << endl;
+            if (!runWorkers(handDists, boardCards, evaluator, procs, exact, merged))
+            {
+                cerr << "enumeration failed, a worker did not finish" << endl;
+                return 1;
+            }
         }
+        catch (std::exception& e)
+        {
+            cerr << "enumeration failed: " << e.what() << endl;
+            return 1;
+        }
+        if (!quiet)
+            printResults(merged.equities(), hands);
+        return 0;
+    }
+
+    // calcuate the results in the background, so that we can report
+    // progress and stop early on an interrupt or a time limit
+    bool progress = !quiet && isatty(fileno(stderr));
+    double maxTime = vm.count("max-time") ? vm["max-time"].as<double>() : 0.0;
+    signal(SIGINT, onInterrupt);
+
+    EquityJob job(handDists, boardCards, evaluator);
+    if (combos)
+        job.setCombos();
+    std::unique_ptr<EnumerationCheckpoint> checkpoint;
+    if (checkpointing)
+    {
+        string filename = vm.count("resume") ? vm["resume"].as<string>()
+                                             : vm["checkpoint"].as<string>();
+        checkpoint.reset(new EnumerationCheckpoint(
+            filename, vm["checkpoint-interval"].as<double>()));
+        PartialEquity part;
+        try
+        {
+            ShowdownEnumerator showdown;
+            part = PartialEquity(PartialEquity::fingerprint(handDists, boardCards, *evaluator),
+                                 showdown.countShowdowns(handDists, boardCards, evaluator),
+                                 handDists.size(), exact);
+        }
+        catch (std::exception& e)
+        {
+            cerr << "enumeration failed: " << e.what() << endl;
+            return 1;
+        }
+        if (vm.count("resume"))
+        {
+            PartialEquity saved;
+            if (!checkpoint->load(saved) || saved.fingerprint() != part.fingerprint())
+            {
+                cerr << "unable to resume, " << filename
+                     << " is not a checkpoint of this enumeration" << endl;
+                return 1;
+            }
+            part = saved;
+            if (!quiet)
+                cerr << boost::format("resuming at %.1f%%\n")
+                            % (100.0 * part.covered() / max<uint64_t>(part.total(), 1));
+        }
+        part.setLabels(hands);
+        job.setWork(part, 0, ShowdownEnumerator::ALL_SHOWDOWNS, checkpoint.get());
+    }
+    job.start();
+    while (!job.done())
+    {
+        if (interrupted || (maxTime > 0.0 && job.elapsed() > maxTime))
+            job.cancel();
+        if (progress)
+            printProgress(job);
+        this_thread::sleep_for(chrono::milliseconds(100));
+    }
+    job.wait();
+    signal(SIGINT, SIG_DFL);
+    if (progress)
+    {
+        printProgress(job);
+        cerr << endl;
+    }
+
+    if (!job.error().empty())
+    {
+        cerr << "enumeration failed: " << job.error() << endl;
+        return 1;
+    }
+    if (job.cancelled() && job.fraction() < 1.0)
+        cerr << boost::format("enumeration stopped at %.1f%%, results are partial\n")
+                    % (job.fraction() * 100.0);
+    if (checkpoint && !job.partial().complete())
+    {
+        PartialEquity part = job.partial();
+        cerr << boost::format("progress saved at %.1f%%, continue with --resume %s\n")
+                    % (100.0 * part.covered() / max<uint64_t>(part.total(), 1))
+                    % checkpoint->filename();
+    }
+
+    if (vm.count("stats") > 0)
+    {
+        if (EnumerationStats::enabled())
+            cerr << job.stats().str();
+        else
+            cerr << "statistics are not available, rebuild with -DPOKERSTOVE_STATS=ON" << endl;
+    }
+
+    // print the results
+    if (!quiet)
+    {
+        printResults(job.results(), hands);
+        if (combos)
+            printCombos(job.combos(), handDists, hands);
     }
 }
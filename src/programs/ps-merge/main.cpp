@@ -0,0 +1,101 @@
+#include <boost/format.hpp>
+#include <boost/program_options.hpp>
+#include <iostream>
+#include <pokerstove/penum/PartialEquity.h>
+#include <string>
+#include <vector>
+
+using namespace std;
+namespace po = boost::program_options;
+using namespace pokerstove;
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        po::options_description desc(
+            "ps-merge, a utility which combines the partial results of an\n"
+            "enumeration split with ps-eval --shard\n");
+
+        desc.add_options()
+            ("help,?",      "produce help message")
+            ("input,i",     po::value<vector<string>>(),  "partial result files to merge")
+            ("output,o",    po::value<string>(),          "file to save the merged results to")
+            ("quiet,q",     "produces no output");
+
+        po::positional_options_description p;
+        p.add("input", -1);
+
+        po::variables_map vm;
+        po::store(po::command_line_parser(argc, argv)
+                      .style(po::command_line_style::unix_style)
+                      .options(desc)
+                      .positional(p)
+                      .run(),
+                  vm);
+        po::notify(vm);
+
+        // check for help
+        if (vm.count("help") || vm.count("input") == 0)
+        {
+            cout << desc << endl;
+            return 1;
+        }
+
+        vector<string> inputs = vm["input"].as<vector<string>>();
+        PartialEquity merged;
+        for (size_t i = 0; i < inputs.size(); i++)
+        {
+            PartialEquity part;
+            if (!part.load(inputs[i]))
+            {
+                cerr << "unable to load partial results: " << inputs[i] << endl;
+                return 1;
+            }
+            if (i == 0)
+                merged = part;
+            else if (!merged.merge(part))
+            {
+                cerr << "partial results do not belong together or overlap: "
+                     << inputs[i] << endl;
+                return 1;
+            }
+        }
+
+        if (vm.count("output") && !merged.save(vm["output"].as<string>()))
+        {
+            cerr << "unable to save merged results: " << vm["output"].as<string>() << endl;
+            return 1;
+        }
+
+        if (!merged.complete())
+            cerr << boost::format("results cover %d of %d showdowns (%.1f%%), they are partial\n")
+                        % merged.covered() % merged.total()
+                        % (merged.total() ? 100.0 * merged.covered() / merged.total() : 0.0);
+
+        if (vm.count("quiet") == 0)
+        {
+            vector<EquityResult> equities = merged.equities();
+            const vector<string>& labels = merged.labels();
+            for (size_t i = 0; i < equities.size(); i++)
+            {
+                string handDesc = (i < labels.size() && !labels[i].empty())
+                                      ? "The hand " + labels[i]
+                                      : "A random hand";
+                cout << handDesc << " has " << equities[i].equity * 100.
+                     << " % equity (" << equities[i].str() << ")" << endl;
+            }
+        }
+    }
+    catch (std::exception& e)
+    {
+        cerr << "-- caught exception--\n" << e.what() << "\n";
+        return 1;
+    }
+    catch (...)
+    {
+        cerr << "Exception of unknown type!\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,91 @@
+#include <boost/format.hpp>
+#include <boost/program_options.hpp>
+#include <iostream>
+#include <pokerstove/penum/HandOrdering.h>
+#include <string>
+
+using namespace std;
+namespace po = boost::program_options;
+using namespace pokerstove;
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        // set up the program options, handle the help case, and extract the
+        // values
+        po::options_description desc(
+            "ps-order, a utility which orders the starting hands of a game\n"
+            "by equity against a random hand, and saves the ordering for\n"
+            "use in percentage ranges\n");
+
+        desc.add_options()
+            ("help,?",      "produce help message")
+            ("game,g",      po::value<string>()->default_value("h"),       "game to order")
+            ("boards,b",    po::value<size_t>()->default_value(1000),      "boards sampled per hand class")
+            ("opponents,n", po::value<size_t>()->default_value(200),       "opponent hands sampled per hand class")
+            ("seed,s",      po::value<unsigned int>()->default_value(0),   "random seed")
+            ("output,o",    po::value<string>(),                           "file to save the ordering to")
+            ("input,i",     po::value<string>(),                           "print a saved ordering instead of building one");
+
+        po::variables_map vm;
+        po::store(po::command_line_parser(argc, argv)
+                      .style(po::command_line_style::unix_style)
+                      .options(desc)
+                      .run(),
+                  vm);
+        po::notify(vm);
+
+        // check for help
+        if (vm.count("help") || argc == 1)
+        {
+            cout << desc << endl;
+            return 1;
+        }
+
+        HandOrdering ordering;
+        if (vm.count("input"))
+        {
+            string input = vm["input"].as<string>();
+            if (!ordering.load(input))
+            {
+                cerr << "unable to load ordering: " << input << endl;
+                return 1;
+            }
+        }
+        else
+        {
+            ordering.build(vm["game"].as<string>(),
+                           vm["boards"].as<size_t>(),
+                           vm["opponents"].as<size_t>(),
+                           vm["seed"].as<unsigned int>());
+        }
+
+        if (vm.count("output"))
+        {
+            string output = vm["output"].as<string>();
+            if (!ordering.save(output))
+            {
+                cerr << "unable to save ordering: " << output << endl;
+                return 1;
+            }
+        }
+        else
+        {
+            for (size_t i = 0; i < ordering.size(); i++)
+                cout << boost::format("%s: %.4f\n") % ordering.hand(i).str()
+                            % ordering.equity(i);
+        }
+    }
+    catch (std::exception& e)
+    {
+        cerr << "-- caught exception--\n" << e.what() << "\n";
+        return 1;
+    }
+    catch (...)
+    {
+        cerr << "Exception of unknown type!\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,166 @@
+#include <boost/format.hpp>
+#include <boost/program_options.hpp>
+#include <iostream>
+#include <pokerstove/penum/EquityHistogram.h>
+#include <pokerstove/penum/EquityTable.h>
+#include <pokerstove/penum/RangeDistribution.h>
+#include <string>
+#include <vector>
+
+using namespace std;
+namespace po = boost::program_options;
+using namespace pokerstove;
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        // set up the program options, handle the help case, and extract the
+        // values
+        po::options_description desc(
+            "ps-table, a utility which builds and queries tables of hold'em\n"
+            "equity against a random hand for every canonical board, or of\n"
+            "histograms of equity on the next street for every flop or turn\n");
+
+        desc.add_options()
+            ("help,?",   "produce help message")
+            ("street,s", po::value<string>()->default_value("river"), "street to build: flop, turn, or river")
+            ("output,o", po::value<string>(),                         "file to write the table to")
+            ("input,i",  po::value<string>(),                         "table to query")
+            ("hand,h",   po::value<string>(),                         "pocket cards to look up")
+            ("board,b",  po::value<string>(),                         "board to look up")
+            ("histogram,H", po::value<size_t>(),                      "build equity histograms with this many bins")
+            ("range,r",  po::value<string>(),                         "opponent range for histograms, a random hand by default")
+            ("threads,t", po::value<size_t>()->default_value(1),      "threads to build histograms with");
+
+        po::variables_map vm;
+        po::store(po::command_line_parser(argc, argv)
+                      .style(po::command_line_style::unix_style)
+                      .options(desc)
+                      .run(),
+                  vm);
+        po::notify(vm);
+
+        // check for help
+        if (vm.count("help") || argc == 1)
+        {
+            cout << desc << endl;
+            return 1;
+        }
+
+        if (vm.count("output"))
+        {
+            string street = vm["street"].as<string>();
+            size_t boardSize = 0;
+            if (street == "flop")
+                boardSize = 3;
+            else if (street == "turn")
+                boardSize = 4;
+            else if (street == "river")
+                boardSize = 5;
+            else
+            {
+                cerr << "unknown street: " << street << endl;
+                return 1;
+            }
+
+            string output = vm["output"].as<string>();
+            vector<CardSet> boards = EquityTable::canonicalBoards(boardSize);
+            bool written = false;
+            if (vm.count("histogram"))
+            {
+                vector<double> weights;
+                if (vm.count("range"))
+                {
+                    RangeDistribution range;
+                    if (!range.parse(vm["range"].as<string>()))
+                    {
+                        cerr << "unable to parse range: "
+                             << vm["range"].as<string>() << endl;
+                        return 1;
+                    }
+                    weights = EquityHistogram::rangeWeights(range);
+                }
+                written = EquityHistogram::generate(
+                    output, boards, vm["histogram"].as<size_t>(), weights,
+                    vm["threads"].as<size_t>());
+            }
+            else
+                written = EquityTable::generate(output, boards);
+            if (!written)
+            {
+                cerr << "unable to write table: " << output << endl;
+                return 1;
+            }
+            cout << boost::format("wrote %d boards to %s\n") % boards.size()
+                        % output;
+        }
+
+        if (vm.count("input"))
+        {
+            string input = vm["input"].as<string>();
+            EquityHistogram histograms;
+            if (histograms.open(input))
+            {
+                if (!vm.count("hand") || !vm.count("board"))
+                {
+                    cout << boost::format("%s: %d boards of %d cards, %d bins\n")
+                                % input % histograms.numBoards()
+                                % histograms.boardSize() % histograms.bins();
+                    return 0;
+                }
+
+                CardSet hand(vm["hand"].as<string>());
+                CardSet board(vm["board"].as<string>());
+                vector<int> counts = histograms.histogram(hand, board);
+                if (counts.empty())
+                {
+                    cerr << "no entry for " << hand.str() << " on "
+                         << board.str() << endl;
+                    return 1;
+                }
+                cout << boost::format("%s on %s:") % hand.str() % board.str();
+                for (int n : counts)
+                    cout << " " << n;
+                cout << endl;
+                return 0;
+            }
+
+            EquityTable table;
+            if (!table.open(input))
+            {
+                cerr << "unable to open table: " << input << endl;
+                return 1;
+            }
+            if (!vm.count("hand") || !vm.count("board"))
+            {
+                cout << boost::format("%s: %d boards of %d cards\n") % input
+                            % table.numBoards() % table.boardSize();
+                return 0;
+            }
+
+            CardSet hand(vm["hand"].as<string>());
+            CardSet board(vm["board"].as<string>());
+            double equity = table.equity(hand, board);
+            if (equity < 0.0)
+            {
+                cerr << "no entry for " << hand.str() << " on " << board.str()
+                     << endl;
+                return 1;
+            }
+            cout << boost::format("%s on %s: %.4f\n") % hand.str() % board.str()
+                        % equity;
+        }
+    }
+    catch (std::exception& e)
+    {
+        cerr << "-- caught exception--\n" << e.what() << "\n";
+        return 1;
+    }
+    catch (...)
+    {
+        cerr << "Exception of unknown type!\n";
+        return 1;
+    }
+    return 0;
+}